@@ -0,0 +1,63 @@
+#include "board.h"
+
+int clearFullRows(Board &board, int firstRow, int lastRow, int clearedRows[GRID_VERTICAL_SIZE])
+{
+    if (firstRow < 0)
+        firstRow = 0;
+    if (lastRow >= GRID_VERTICAL_SIZE)
+        lastRow = GRID_VERTICAL_SIZE - 1;
+
+    // Only rows touched by the last lock can have become full
+    bool anyFull = false;
+    for (int y = firstRow; y <= lastRow; y++)
+    {
+        if (board.rows[y] == FULL_ROW)
+        {
+            anyFull = true;
+            break;
+        }
+    }
+    if (!anyFull)
+        return 0;
+
+    int linesCleared = 0;
+    int writeY = lastRow;
+    for (int readY = lastRow; readY >= 0; readY--)
+    {
+        if (board.rows[readY] == FULL_ROW)
+        {
+            // Every cleared line below has already pulled this one down by a row
+            clearedRows[linesCleared] = readY + linesCleared;
+            linesCleared++;
+        }
+        else
+        {
+            board.rows[writeY] = board.rows[readY];
+            writeY--;
+        }
+    }
+    for (int y = writeY; y >= 0; y--)
+    {
+        board.rows[y] = EMPTY_ROW;
+    }
+
+    board.blockCount -= linesCleared * GRID_HORIZONTAL_SIZE;
+    updateSurface(board);
+    return linesCleared;
+}
+
+void updateSurface(Board &board)
+{
+    uint16_t remaining = FULL_ROW;
+    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+        board.surface[x] = GRID_VERTICAL_SIZE;
+
+    for (int y = 0; y < GRID_VERTICAL_SIZE && remaining != EMPTY_ROW; y++)
+    {
+        for (uint16_t found = board.rows[y] & remaining; found != EMPTY_ROW; found &= found - 1)
+        {
+            board.surface[__builtin_ctz(found)] = (int8_t)y;
+        }
+        remaining &= (uint16_t)~board.rows[y];
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdint.h>
+
+int const GRID_HORIZONTAL_SIZE = 16;
+int const GRID_VERTICAL_SIZE = 22;
+
+uint16_t const EMPTY_ROW = 0x0000;
+uint16_t const FULL_ROW = 0xFFFF;
+
+// Bitboard: one row per uint16_t, bit x of rows[y] is the cell at column x.
+// With the block count and the column surfaces the board is 62 bytes. It has no alignment of its own, so where it
+// falls against cache lines depends on what holds it.
+struct Board
+{
+    uint16_t rows[GRID_VERTICAL_SIZE];
+    int16_t blockCount;                   // Filled cells, kept up to date so the empty-grid check is O(1)
+    int8_t surface[GRID_HORIZONTAL_SIZE]; // Row of the topmost filled cell per column, GRID_VERTICAL_SIZE if none
+};
+
+static_assert(sizeof(Board) == 62, "Board grew, update the size stated above");
+
+// A piece as up to four consecutive row masks, rows[0] being the row at `top`
+int const PIECE_MASK_ROWS = 4;
+
+struct PieceMask
+{
+    int top;
+    uint16_t rows[PIECE_MASK_ROWS];
+};
+
+inline void clearBoard(Board &board)
+{
+    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
+        board.rows[y] = EMPTY_ROW;
+    board.blockCount = 0;
+    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+        board.surface[x] = GRID_VERTICAL_SIZE;
+}
+
+inline bool isCellFilled(Board const &board, int x, int y)
+{
+    return (board.rows[y] >> x) & 1;
+}
+
+inline void fillCell(Board &board, int x, int y)
+{
+    if (!isCellFilled(board, x, y))
+        board.blockCount++;
+    board.rows[y] |= (uint16_t)(1u << x);
+    if (y < board.surface[x])
+        board.surface[x] = (int8_t)y;
+}
+
+inline bool isBoardEmpty(Board const &board)
+{
+    return board.blockCount == 0;
+}
+
+// Adds cell (x, y) to the mask, growing it downwards from `top`
+inline void addMaskCell(PieceMask &mask, int x, int y)
+{
+    mask.rows[y - mask.top] |= (uint16_t)(1u << x);
+}
+
+// True if the mask, moved by (dx, dy) with dx in [-1, 1], leaves the board or overlaps a filled cell
+inline bool collides(Board const &board, PieceMask const &mask, int dx = 0, int dy = 0)
+{
+    for (int r = 0; r < PIECE_MASK_ROWS; r++)
+    {
+        uint16_t row = mask.rows[r];
+        if (row == EMPTY_ROW)
+            continue;
+
+        // Walls: a shift that would push a bit past either edge is a collision
+        if (dx < 0)
+        {
+            if (row & 0x0001)
+                return true;
+            row >>= 1;
+        }
+        else if (dx > 0)
+        {
+            if (row & 0x8000)
+                return true;
+            row <<= 1;
+        }
+
+        int y = mask.top + r + dy;
+        if (y < 0 || y >= GRID_VERTICAL_SIZE)
+            return true;
+        if (board.rows[y] & row)
+            return true;
+    }
+    return false;
+}
+
+// Locks the mask into the board. The mask must not overlap filled cells.
+inline void placeMask(Board &board, PieceMask const &mask)
+{
+    // Bottom-up, so the last write to a column's surface is its topmost new cell
+    for (int r = PIECE_MASK_ROWS - 1; r >= 0; r--)
+    {
+        uint16_t row = mask.rows[r];
+        if (row == EMPTY_ROW)
+            continue;
+
+        int y = mask.top + r;
+        board.rows[y] |= row;
+        board.blockCount += __builtin_popcount(row);
+        for (; row != EMPTY_ROW; row &= row - 1)
+        {
+            int x = __builtin_ctz(row);
+            if (y < board.surface[x])
+                board.surface[x] = (int8_t)y;
+        }
+    }
+}
+
+// Removes every full row in [firstRow, lastRow] and drops the rows above in a single pass.
+// clearedRows receives, bottom to top, the row each cleared line sits on at the moment it is
+// removed (i.e. after the lines below it have already been removed). Returns the number of lines.
+int clearFullRows(Board &board, int firstRow, int lastRow, int clearedRows[GRID_VERTICAL_SIZE]);
+
+// Recomputes Board::surface from the rows, top-down until every column has been found
+void updateSurface(Board &board);
+
+#endif // !BOARD_H
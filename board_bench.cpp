@@ -0,0 +1,179 @@
+// Micro-benchmark: bitboard collision queries against the original int grid versions.
+// Build and run with `make bench`.
+
+#include "board.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+int const BOARDS = 64;
+int const PIECES = 1024;
+int const ROUNDS = 2000;
+
+struct Cell
+{
+    float x;
+    float y;
+};
+
+struct Piece
+{
+    Cell units[4];
+    int size = 4;
+};
+
+// The original representation, one int per cell
+static int grids[BOARDS][GRID_VERTICAL_SIZE][GRID_HORIZONTAL_SIZE];
+static Board boards[BOARDS];
+static Piece pieces[PIECES];
+// The same pieces as row masks, built once like game.cpp keeps them, so the timing covers the queries alone
+static PieceMask masks[PIECES];
+
+static bool gridCanMoveDown(int grid[GRID_VERTICAL_SIZE][GRID_HORIZONTAL_SIZE], Piece piece)
+{
+    for (int i = 0; i < piece.size; i++)
+    {
+        float newY = piece.units[i].y + 1;
+        int x = (int)piece.units[i].x;
+
+        if (newY >= GRID_VERTICAL_SIZE || grid[(int)newY][x] == 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool gridCanMoveHorizontally(int grid[GRID_VERTICAL_SIZE][GRID_HORIZONTAL_SIZE], Piece piece, int amount)
+{
+    for (int i = 0; i < piece.size; i++)
+    {
+        Cell newPos = piece.units[i];
+        newPos.x += amount;
+
+        if (newPos.x < 0 || newPos.x >= GRID_HORIZONTAL_SIZE)
+        {
+            return false;
+        }
+        if (grid[(int)piece.units[i].y][(int)newPos.x] == 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool gridOverlaps(int grid[GRID_VERTICAL_SIZE][GRID_HORIZONTAL_SIZE], Piece piece)
+{
+    for (int i = 0; i < piece.size; i++)
+    {
+        if (grid[(int)piece.units[i].y][(int)piece.units[i].x] == 1)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static PieceMask maskOf(Piece const &piece)
+{
+    PieceMask mask = {GRID_VERTICAL_SIZE, {EMPTY_ROW, EMPTY_ROW, EMPTY_ROW, EMPTY_ROW}};
+    for (int i = 0; i < piece.size; i++)
+    {
+        if ((int)piece.units[i].y < mask.top)
+            mask.top = (int)piece.units[i].y;
+    }
+    for (int i = 0; i < piece.size; i++)
+    {
+        addMaskCell(mask, (int)piece.units[i].x, (int)piece.units[i].y);
+    }
+    return mask;
+}
+
+static void setup()
+{
+    srand(12345);
+    for (int b = 0; b < BOARDS; b++)
+    {
+        clearBoard(boards[b]);
+        // Fill the bottom half with a ragged stack
+        for (int y = GRID_VERTICAL_SIZE / 2; y < GRID_VERTICAL_SIZE; y++)
+        {
+            for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+            {
+                int filled = rand() % 3 != 0;
+                grids[b][y][x] = filled;
+                if (filled)
+                    fillCell(boards[b], x, y);
+            }
+        }
+    }
+
+    // A T piece at random places, kept off the walls so every query is legal for both versions
+    for (int p = 0; p < PIECES; p++)
+    {
+        float x = (float)(1 + rand() % (GRID_HORIZONTAL_SIZE - 2));
+        float y = (float)(rand() % (GRID_VERTICAL_SIZE - 2));
+        pieces[p].units[0] = {x, y};
+        pieces[p].units[1] = {x - 1, y + 1};
+        pieces[p].units[2] = {x, y + 1};
+        pieces[p].units[3] = {x + 1, y + 1};
+        masks[p] = maskOf(pieces[p]);
+    }
+}
+
+static double elapsedNs(std::chrono::steady_clock::time_point start)
+{
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+int main()
+{
+    setup();
+
+    long const queries = (long)ROUNDS * PIECES * 4;
+    long gridHits = 0;
+    long boardHits = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        int (*grid)[GRID_HORIZONTAL_SIZE] = grids[r % BOARDS];
+        for (int p = 0; p < PIECES; p++)
+        {
+            gridHits += gridCanMoveDown(grid, pieces[p]);
+            gridHits += gridCanMoveHorizontally(grid, pieces[p], -1);
+            gridHits += gridCanMoveHorizontally(grid, pieces[p], 1);
+            gridHits += gridOverlaps(grid, pieces[p]);
+        }
+    }
+    double gridNs = elapsedNs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        Board const &board = boards[r % BOARDS];
+        for (int p = 0; p < PIECES; p++)
+        {
+            PieceMask const &mask = masks[p];
+            boardHits += !collides(board, mask, 0, 1);
+            boardHits += !collides(board, mask, -1, 0);
+            boardHits += !collides(board, mask, 1, 0);
+            boardHits += collides(board, mask);
+        }
+    }
+    double boardNs = elapsedNs(start);
+
+    if (gridHits != boardHits)
+    {
+        printf("Mismatch: int grid %ld, bitboard %ld\n", gridHits, boardHits);
+        return 1;
+    }
+
+    printf("Board size: int grid %d bytes, bitboard %d bytes\n", (int)sizeof(grids[0]), (int)sizeof(Board));
+    printf("int grid:  %8.2f ns/query\n", gridNs / queries);
+    printf("bitboard:  %8.2f ns/query (%.1fx)\n", boardNs / queries, gridNs / boardNs);
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "bot.h"
+
+#include <stdlib.h>
+
+// Placement weights over the board a candidate leaves behind (after Yiyuan Lee's tuned
+// aggregate height / lines / holes / bumpiness evaluator)
+static float const HEIGHT_WEIGHT = -0.51f;
+static float const LINES_WEIGHT = 0.76f;
+static float const HOLES_WEIGHT = -0.36f;
+static float const BUMPINESS_WEIGHT = -0.18f;
+
+// Ticks without progress before the bot gives up on its rotation or column
+static int const STUCK_TICKS = SIM_TICK_RATE / 2;
+
+static float evaluateBoard(Board const &board, int lines)
+{
+    // Holes are empty cells under a filled one, counted a row at a time against the columns covered so far
+    int holes = 0;
+    uint16_t covered = EMPTY_ROW;
+    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
+    {
+        holes += __builtin_popcount((uint16_t)(covered & ~board.rows[y]));
+        covered |= board.rows[y];
+    }
+
+    int aggregateHeight = 0;
+    int bumpiness = 0;
+    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+    {
+        aggregateHeight += GRID_VERTICAL_SIZE - board.surface[x];
+        if (x > 0)
+            bumpiness += abs(board.surface[x] - board.surface[x - 1]);
+    }
+
+    return HEIGHT_WEIGHT * aggregateHeight + LINES_WEIGHT * lines + HOLES_WEIGHT * holes +
+           BUMPINESS_WEIGHT * bumpiness;
+}
+
+static void planPiece(Bot &bot, Game const &game)
+{
+    Tetromino const &piece = game.currentPiece;
+    int pivotX = piece.x;
+    int pivotY = piece.y;
+
+    bot.plannedPiece = game.piecesSpawned;
+    bot.targetRotation = piece.rotation;
+    bot.targetX = pivotX;
+    bot.lastX = pivotX;
+    bot.lastRotation = piece.rotation;
+    bot.stuckTicks = 0;
+
+    bool found = false;
+    float bestScore = 0.0f;
+    for (int rotation = 0; rotation < PIECE_ORIENTATIONS; rotation++)
+    {
+        PieceShape const &shape = pieceShape(piece.type, rotation);
+        // Turning below the ceiling pushes the piece down, as rotatePiece does
+        int y = pivotY + shape.top < 0 ? -shape.top : pivotY;
+
+        for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+        {
+            if (!shapeFits(shape, x, y))
+                continue;
+            PieceMask mask = shapeMask(shape, x, y);
+            if (collides(game.board, mask))
+                continue;
+            mask.top += dropDistance(game.board, shape, x, y);
+
+            Board board = game.board;
+            placeMask(board, mask);
+            int clearedRows[GRID_VERTICAL_SIZE];
+            int lines = clearFullRows(board, mask.top, mask.top + PIECE_MASK_ROWS - 1, clearedRows);
+
+            float score = evaluateBoard(board, lines);
+            if (!found || score > bestScore)
+            {
+                found = true;
+                bestScore = score;
+                bot.targetRotation = rotation;
+                bot.targetX = x;
+            }
+        }
+    }
+}
+
+void initBot(Bot &bot)
+{
+    bot.plannedPiece = 0;
+    bot.targetRotation = 0;
+    bot.targetX = 0;
+    bot.lastX = 0;
+    bot.lastRotation = 0;
+    bot.stuckTicks = 0;
+}
+
+GameInput botInput(Bot &bot, Game const &game)
+{
+    GameInput input = {0, 0};
+
+    if (game.phase == PHASE_TRANSITION)
+    {
+        input.pressed = INPUT_SKIP;
+        return input;
+    }
+    // The piece left over from a level transition keeps falling in the NEW state
+    PieceState state = game.currentPiece.pieceState;
+    if (game.phase != PHASE_PLAYING || game.paused || (state != FALL && state != NEW) || game.isInFreeFall)
+        return input;
+
+    if (bot.plannedPiece != game.piecesSpawned)
+        planPiece(bot, game);
+
+    int x = game.currentPiece.x;
+    int rotation = game.currentPiece.rotation;
+    if (x != bot.lastX || rotation != bot.lastRotation)
+    {
+        bot.lastX = x;
+        bot.lastRotation = rotation;
+        bot.stuckTicks = 0;
+    }
+    else
+    {
+        bot.stuckTicks++;
+    }
+
+    // Turn first, kicks may shift the pivot that the lateral moves then correct
+    if (rotation != bot.targetRotation)
+    {
+        if (bot.stuckTicks <= STUCK_TICKS)
+        {
+            input.pressed = INPUT_UP;
+            return input;
+        }
+        bot.targetRotation = rotation;
+        bot.stuckTicks = 0;
+    }
+
+    if (x == bot.targetX || bot.stuckTicks > STUCK_TICKS)
+        input.pressed = INPUT_SPACE;
+    else
+        input.down = x < bot.targetX ? INPUT_RIGHT : INPUT_LEFT;
+    return input;
+}
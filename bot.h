@@ -0,0 +1,26 @@
+#ifndef BOT_H
+#define BOT_H
+
+// A simple placement bot that plays through the normal input path, one GameInput per tick, so
+// headless runs exercise exactly the code a player does.
+
+#include "game.h"
+
+#include <stdint.h>
+
+struct Bot
+{
+    uint32_t plannedPiece; // Game::piecesSpawned the current plan is for
+    int targetRotation;
+    int targetX; // Column of the pivot to drop from
+    int lastX;
+    int lastRotation;
+    int stuckTicks; // Ticks since the piece last moved or turned
+};
+
+void initBot(Bot &bot);
+
+// Decides the input for the next tick of game
+GameInput botInput(Bot &bot, Game const &game);
+
+#endif // !BOT_H
@@ -0,0 +1,407 @@
+// tetris-test: checks the core rules headless, against libtetriscore.
+// Build and run with `make test`; exits non-zero if any check fails.
+
+#include "bot.h"
+#include "replay.h"
+#include "sim_thread.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+static int checks = 0;
+static int failures = 0;
+
+#define CHECK(condition)                                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        checks++;                                                                                                      \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            failures++;                                                                                                \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);                                     \
+        }                                                                                                              \
+    } while (0)
+
+static void fillRow(Board &board, int y, uint16_t row)
+{
+    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+    {
+        if ((row >> x) & 1)
+            fillCell(board, x, y);
+    }
+}
+
+static void testClearFullRows()
+{
+    Board board;
+    clearBoard(board);
+    fillRow(board, 21, FULL_ROW);
+    fillRow(board, 20, FULL_ROW);
+    fillRow(board, 19, 0x00F0);
+    fillRow(board, 18, FULL_ROW);
+    fillRow(board, 17, 0x0101);
+
+    int clearedRows[GRID_VERTICAL_SIZE];
+    int lines = clearFullRows(board, 18, 21, clearedRows);
+    CHECK(lines == 3);
+    // Bottom to top, each where it sits once the lines below it are gone
+    CHECK(clearedRows[0] == 21);
+    CHECK(clearedRows[1] == 21);
+    CHECK(clearedRows[2] == 20);
+
+    // The partial rows drop onto the floor in order, everything above is empty
+    CHECK(board.rows[21] == 0x00F0);
+    CHECK(board.rows[20] == 0x0101);
+    for (int y = 0; y < 20; y++)
+    {
+        CHECK(board.rows[y] == EMPTY_ROW);
+    }
+    CHECK(board.blockCount == 6);
+    CHECK(board.surface[0] == 20);
+    CHECK(board.surface[4] == 21);
+    CHECK(board.surface[1] == GRID_VERTICAL_SIZE);
+
+    // Nothing full in range: the board is untouched
+    Board before = board;
+    CHECK(clearFullRows(board, 0, GRID_VERTICAL_SIZE - 1, clearedRows) == 0);
+    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
+    {
+        CHECK(board.rows[y] == before.rows[y]);
+    }
+}
+
+// Row by row reference for dropDistance
+static int scanDropDistance(Board const &board, PieceShape const &shape, int x, int y)
+{
+    int distance = 0;
+    while (!collides(board, shapeMask(shape, x, y + distance), 0, 1))
+    {
+        distance++;
+    }
+    return distance;
+}
+
+static void testDropDistance()
+{
+    Board board;
+    clearBoard(board);
+    CHECK(dropDistance(board, pieceShape(PIECE_O, 0), 5, 0) == GRID_VERTICAL_SIZE - 2);
+
+    // Tucked under an overhang, the column surfaces are above the piece: the scan fallback takes over
+    fillCell(board, 5, 5);
+    fillCell(board, 6, 5);
+    fillRow(board, 21, 0x0060);
+    CHECK(dropDistance(board, pieceShape(PIECE_O, 0), 5, 8) == 11);
+
+    // Every shape at every free spot of ragged stacks agrees with the scan
+    Rng rng;
+    seedRng(rng, 7, 0);
+    int mismatches = 0;
+    for (int b = 0; b < 50; b++)
+    {
+        clearBoard(board);
+        for (int y = 8; y < GRID_VERTICAL_SIZE; y++)
+        {
+            fillRow(board, y, (uint16_t)(randomBelow(rng, 0x10000) & randomBelow(rng, 0x10000)));
+        }
+        for (int type = 0; type < TOTAL_PIECES_TYPES; type++)
+        {
+            for (int rotation = 0; rotation < PIECE_ORIENTATIONS; rotation++)
+            {
+                PieceShape const &shape = pieceShape(type, rotation);
+                for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
+                {
+                    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+                    {
+                        if (!shapeFits(shape, x, y) || collides(board, shapeMask(shape, x, y)))
+                            continue;
+                        if (dropDistance(board, shape, x, y) != scanDropDistance(board, shape, x, y))
+                            mismatches++;
+                    }
+                }
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+static Tetromino pieceAt(PieceType type, int rotation, int x, int y)
+{
+    Tetromino piece;
+    piece.type = (uint8_t)type;
+    piece.rotation = (uint8_t)rotation;
+    piece.x = (int8_t)x;
+    piece.y = (int8_t)y;
+    piece.pieceState = FALL;
+    return piece;
+}
+
+static void testWallKicks()
+{
+    Board board;
+    clearBoard(board);
+
+    // A vertical I against the right wall turns flat one column in
+    Tetromino rotated = rotatePiece(board, pieceAt(PIECE_I, 1, GRID_HORIZONTAL_SIZE - 1, 5));
+    CHECK(rotated.rotation == 2);
+    CHECK(rotated.x == GRID_HORIZONTAL_SIZE - 2);
+    CHECK(rotated.y == 5);
+
+    // Against the left wall the -1 kick is tried first and fails, +1 fits
+    rotated = rotatePiece(board, pieceAt(PIECE_I, 3, 0, 5));
+    CHECK(rotated.rotation == 0);
+    CHECK(rotated.x == 1);
+
+    // Free space needs no kick
+    rotated = rotatePiece(board, pieceAt(PIECE_T, 0, 5, 5));
+    CHECK(rotated.rotation == 1);
+    CHECK(rotated.x == 5 && rotated.y == 5);
+
+    // Walled in on both sides and above: no kick fits and the piece stays as it was
+    for (int y = 3; y < 8; y++)
+    {
+        fillRow(board, y, (uint16_t)~0x0018);
+    }
+    fillRow(board, 3, 0x0018);
+    Tetromino vertical = pieceAt(PIECE_I, 1, 3, 6);
+    CHECK(!collides(board, pieceMask(vertical)));
+    rotated = rotatePiece(board, vertical);
+    CHECK(rotated.rotation == 1);
+    CHECK(rotated.x == 3 && rotated.y == 6);
+}
+
+static void testBagFairness(GeneratorMode mode, int bagSize)
+{
+    int const BAGS = 200;
+    int copies = bagSize / TOTAL_PIECES_TYPES;
+    int unfairBags = 0;
+    for (uint64_t seed = 1; seed <= 20; seed++)
+    {
+        PieceGenerator generator;
+        initGenerator(generator, seed, mode);
+        for (int bag = 0; bag < BAGS; bag++)
+        {
+            int counts[TOTAL_PIECES_TYPES] = {};
+            for (int i = 0; i < bagSize; i++)
+            {
+                counts[nextPiece(generator)]++;
+            }
+            for (int type = 0; type < TOTAL_PIECES_TYPES; type++)
+            {
+                if (counts[type] != copies)
+                {
+                    unfairBags++;
+                    break;
+                }
+            }
+        }
+    }
+    CHECK(unfairBags == 0);
+}
+
+static void testGenerator()
+{
+    testBagFairness(GENERATOR_BAG_7, 7);
+    testBagFairness(GENERATOR_BAG_14, 14);
+
+    // The same seed deals the same pieces, and the preview shows them before they are dealt
+    PieceGenerator a;
+    PieceGenerator b;
+    initGenerator(a, 42, GENERATOR_RANDOM);
+    initGenerator(b, 42, GENERATOR_RANDOM);
+    int differences = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        PieceType peeked = peekPiece(a, 3);
+        for (int n = 0; n < 3; n++)
+        {
+            if (nextPiece(a) != nextPiece(b))
+                differences++;
+        }
+        if (peekPiece(a, 0) != peeked)
+            differences++;
+    }
+    CHECK(differences == 0);
+}
+
+static void testReplayRoundTrip()
+{
+    Game recorded;
+    ReplayWriter writer;
+    newGame(recorded, 1234, GENERATOR_BAG_7);
+    beginReplay(writer, recorded);
+    Bot bot;
+    initBot(bot);
+    for (int i = 0; i < SIM_TICK_RATE * 120 && recorded.phase != PHASE_OVER; i++)
+    {
+        tick(recorded, botInput(bot, recorded));
+    }
+    endReplay(writer, recorded);
+    CHECK(recorded.piecesSpawned > 10);
+
+    Game replayed;
+    CHECK(playReplay(writer.data.data(), writer.data.size(), replayed) == REPLAY_OK);
+    CHECK(replayed.tickCount == recorded.tickCount);
+    CHECK(replayed.piecesSpawned == recorded.piecesSpawned);
+    CHECK(hashGame(replayed) == hashGame(recorded));
+
+    // A changed final hash is caught, a cut-off recording is rejected
+    std::vector<uint8_t> tampered = writer.data;
+    tampered.back() ^= 1;
+    CHECK(playReplay(tampered.data(), tampered.size(), replayed) == REPLAY_HASH_MISMATCH);
+    tampered.resize(tampered.size() / 2);
+    CHECK(playReplay(tampered.data(), tampered.size(), replayed) == REPLAY_BAD_FORMAT);
+}
+
+static void testStep()
+{
+    GameInput const NONE = {0, 0};
+
+    // Whole ticks run, the remainder waits in the accumulator for the next step
+    Game game;
+    newGame(game, 5, GENERATOR_BAG_7);
+    step(game, NONE, SIM_DT * 2.5f);
+    CHECK(game.tickCount == 2);
+    CHECK(game.accumulator > SIM_DT * 0.49f && game.accumulator < SIM_DT * 0.51f);
+    step(game, NONE, SIM_DT * 0.6f);
+    CHECK(game.tickCount == 3);
+    CHECK(game.accumulator > SIM_DT * 0.09f && game.accumulator < SIM_DT * 0.11f);
+
+    // A hitch longer than MAX_FRAME_TIME plays as MAX_FRAME_TIME
+    Game hitched;
+    Game clamped;
+    newGame(hitched, 5, GENERATOR_BAG_7);
+    newGame(clamped, 5, GENERATOR_BAG_7);
+    step(hitched, NONE, 10.0f);
+    step(clamped, NONE, MAX_FRAME_TIME);
+    CHECK(hitched.tickCount == clamped.tickCount);
+    CHECK(hashGame(hitched) == hashGame(clamped));
+
+    // A press in a step too short for a tick waits for the next tick, then happens once
+    newGame(game, 5, GENERATOR_BAG_7);
+    int rotation = game.currentPiece.rotation;
+    int rotated = rotatePiece(game.board, game.currentPiece).rotation;
+    CHECK(rotated != rotation);
+    GameInput rotate = {0, INPUT_UP};
+    step(game, rotate, SIM_DT * 0.5f);
+    CHECK(game.tickCount == 0);
+    CHECK(game.currentPiece.rotation == rotation);
+    CHECK(game.pendingPressed == INPUT_UP);
+    step(game, NONE, SIM_DT * 3.0f);
+    CHECK(game.tickCount == 3);
+    CHECK(game.currentPiece.rotation == rotated);
+    CHECK(game.pendingPressed == 0);
+}
+
+// A bottomed piece moved off its ledge falls under the fall timer again, not a row every tick
+static void testLedgeSlide()
+{
+    Game game;
+    newGame(game, 5, GENERATOR_BAG_7);
+    game.currentPiece = pieceAt(PIECE_O, 0, 4, 5);
+    game.currentPiece.pieceState = BOTTOMED;
+    game.previousPiece = game.currentPiece;
+    game.bottomedTimer = LOCK_DELAY / 2;
+
+    int ticks = (int)(game.fallSpeed / SIM_DT) - 1;
+    GameInput const NONE = {0, 0};
+    for (int i = 0; i < ticks; i++)
+    {
+        tick(game, NONE);
+    }
+    CHECK(game.currentPiece.y == 6);
+    CHECK(game.currentPiece.pieceState == FALL);
+    CHECK(game.board.blockCount == 0);
+}
+
+static void sleepSeconds(float seconds)
+{
+    std::this_thread::sleep_for(std::chrono::duration<float>(seconds));
+}
+
+// Takes the next snapshot the simulation thread publishes, false if none comes within a second
+static bool awaitSnapshot(Game &game)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        if (takeSnapshot(game))
+            return true;
+        sleepSeconds(0.001f);
+    }
+    return false;
+}
+
+static int countBlocks(Board const &board)
+{
+    int count = 0;
+    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
+    {
+        count += __builtin_popcount(board.rows[y]);
+    }
+    return count;
+}
+
+static void testSimulationThread()
+{
+    Game game;
+    newGame(game, 99, GENERATOR_BAG_7);
+    startSimulation(game);
+
+    // Every snapshot taken is whole and newer than the one before, while the simulation keeps publishing
+    Game shown;
+    CHECK(awaitSnapshot(shown));
+    int stale = 0;
+    int torn = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        uint32_t lastTick = shown.tickCount;
+        CHECK(awaitSnapshot(shown));
+        if (shown.tickCount <= lastTick)
+            stale++;
+        if (countBlocks(shown.board) != shown.board.blockCount)
+            torn++;
+    }
+    CHECK(stale == 0);
+    CHECK(torn == 0);
+
+    // A hard drop locks while the reader skips every snapshot: the lock comes with the next one taken, once
+    GameInput drop = {0, INPUT_SPACE};
+    postSimulationInput(drop);
+    sleepSeconds(LOCK_DELAY + 0.1f);
+    CHECK(awaitSnapshot(shown));
+    CHECK((shown.events & EVENT_PIECE_LOCKED) != 0);
+    CHECK(shown.board.blockCount == 4);
+    sleepSeconds(0.02f);
+    CHECK(awaitSnapshot(shown));
+    CHECK((shown.events & EVENT_PIECE_LOCKED) == 0);
+
+    // Inactive, nothing is published once the step already running has
+    setSimulationActive(false);
+    sleepSeconds(0.02f);
+    takeSnapshot(shown);
+    uint32_t pausedTick = shown.tickCount;
+    sleepSeconds(0.02f);
+    CHECK(!takeSnapshot(shown));
+    setSimulationActive(true);
+    CHECK(awaitSnapshot(shown));
+    CHECK(shown.tickCount > pausedTick);
+
+    stopSimulation();
+    CHECK(game.tickCount >= shown.tickCount);
+}
+
+int main()
+{
+    testClearFullRows();
+    testDropDistance();
+    testWallKicks();
+    testGenerator();
+    testReplayRoundTrip();
+    testStep();
+    testLedgeSlide();
+    testSimulationThread();
+
+    printf("%d checks, %d failed\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
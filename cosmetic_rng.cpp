@@ -0,0 +1,19 @@
+#include "cosmetic_rng.h"
+
+// Stream numbers start past any the game uses
+static uint64_t const FIRST_STREAM = 0x100;
+
+static Rng streams[COSMETIC_STREAMS];
+
+void seedCosmeticRng(uint64_t seed)
+{
+    for (int i = 0; i < COSMETIC_STREAMS; i++)
+    {
+        seedRng(streams[i], seed, FIRST_STREAM + i);
+    }
+}
+
+Rng &cosmeticRng(CosmeticStream stream)
+{
+    return streams[stream];
+}
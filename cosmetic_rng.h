@@ -0,0 +1,22 @@
+#ifndef COSMETIC_RNG_H
+#define COSMETIC_RNG_H
+
+// Randomness for looks only: particles, screen shake and stars. Every subsystem draws from its own stream, all
+// apart from the game's generator and from libc rand(), so effects never change what a seed deals or what a
+// replay reproduces, and one effect's draws never shift another's.
+
+#include "rng.h"
+
+enum CosmeticStream
+{
+    COSMETIC_PARTICLES,
+    COSMETIC_SHAKE,
+    COSMETIC_STARS,
+    COSMETIC_STREAMS
+};
+
+void seedCosmeticRng(uint64_t seed);
+
+Rng &cosmeticRng(CosmeticStream stream);
+
+#endif // !COSMETIC_RNG_H
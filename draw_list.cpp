@@ -0,0 +1,270 @@
+#include "draw_list.h"
+
+#include "rlgl_batch.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+
+// Quads per frame, the rest are dropped. The high score screen, the busiest one, records well under a thousand.
+static int const MAX_DRAW_QUADS = 16384;
+
+// Vertical gap DrawTextEx leaves between lines, raylib's default text line spacing
+static float const TEXT_LINE_SPACING = 2.0f;
+
+struct DrawQuad
+{
+    float x[4]; // Corners in the order top left, bottom left, bottom right, top right
+    float y[4];
+    float u0, v0, u1, v1; // Texture coordinates of the top left and bottom right corners
+    Color color;
+    unsigned int texture;
+    int blend;
+    void (*draw)(void const *data); // Set for custom commands, which have no corners
+    void const *data;
+    int vertices;
+};
+
+static DrawQuad quads[MAX_DRAW_QUADS];
+// Sort keys: layer, blend mode and texture above the index of the quad, so equal states keep their recording order
+static uint64_t keys[MAX_DRAW_QUADS];
+static int quadCount;
+static Vector2 drawOffset;
+static DrawListStats stats;
+
+static DrawQuad *addQuad(DrawLayer layer, unsigned int texture, int blend)
+{
+    if (quadCount == MAX_DRAW_QUADS)
+        return nullptr;
+
+    int index = quadCount++;
+    keys[index] = (uint64_t)layer << 60 | (uint64_t)(blend & 0xF) << 56 | (uint64_t)(texture & 0xFFFFFF) << 32 |
+                  (uint64_t)index;
+    DrawQuad *quad = &quads[index];
+    quad->texture = texture;
+    quad->blend = blend;
+    quad->draw = nullptr;
+    return quad;
+}
+
+static void setCorners(DrawQuad *quad, Rectangle dest)
+{
+    float left = dest.x + drawOffset.x;
+    float top = dest.y + drawOffset.y;
+    float right = left + dest.width;
+    float bottom = top + dest.height;
+    quad->x[0] = left;
+    quad->y[0] = top;
+    quad->x[1] = left;
+    quad->y[1] = bottom;
+    quad->x[2] = right;
+    quad->y[2] = bottom;
+    quad->x[3] = right;
+    quad->y[3] = top;
+}
+
+// Texture coordinates of source as DrawTexturePro computes them, a negative size flipping that axis
+static void setSource(DrawQuad *quad, Texture2D texture, Rectangle source)
+{
+    float width = fabsf(source.width);
+    float height = fabsf(source.height);
+    float left = source.x / texture.width;
+    float right = (source.x + width) / texture.width;
+    float top = source.y / texture.height;
+    float bottom = (source.y + height) / texture.height;
+    quad->u0 = source.width < 0 ? right : left;
+    quad->u1 = source.width < 0 ? left : right;
+    quad->v0 = source.height < 0 ? bottom : top;
+    quad->v1 = source.height < 0 ? top : bottom;
+}
+
+void drawListBegin()
+{
+    quadCount = 0;
+    drawOffset = {0, 0};
+    stats = {0, 0, 0};
+}
+
+void drawListOffset(Vector2 offset)
+{
+    drawOffset = offset;
+}
+
+static void addRectangle(DrawLayer layer, Rectangle rect, Color color)
+{
+    Texture2D shapes = GetShapesTexture();
+    DrawQuad *quad = addQuad(layer, shapes.id, BLEND_ALPHA);
+    if (quad == nullptr)
+        return;
+    setCorners(quad, rect);
+    setSource(quad, shapes, GetShapesTextureRectangle());
+    quad->color = color;
+}
+
+void drawListRectangle(DrawLayer layer, Rectangle rect, Color color)
+{
+    stats.commands++;
+    addRectangle(layer, rect, color);
+}
+
+void drawListRectangleLines(DrawLayer layer, Rectangle rect, float thickness, Color color)
+{
+    stats.commands++;
+    // Top and bottom span the width, the sides fill in between them
+    float side = rect.height - 2 * thickness;
+    addRectangle(layer, {rect.x, rect.y, rect.width, thickness}, color);
+    addRectangle(layer, {rect.x, rect.y + rect.height - thickness, rect.width, thickness}, color);
+    addRectangle(layer, {rect.x, rect.y + thickness, thickness, side}, color);
+    addRectangle(layer, {rect.x + rect.width - thickness, rect.y + thickness, thickness, side}, color);
+}
+
+void drawListTexture(DrawLayer layer, Texture2D texture, Rectangle source, Rectangle dest, Color tint, int blend)
+{
+    stats.commands++;
+    DrawQuad *quad = addQuad(layer, texture.id, blend);
+    if (quad == nullptr)
+        return;
+    setCorners(quad, dest);
+    setSource(quad, texture, source);
+    quad->color = tint;
+}
+
+void drawListText(DrawLayer layer, Font font, char const *text, Vector2 position, float fontSize, float spacing,
+                  Color tint)
+{
+    stats.commands++;
+    float scale = fontSize / font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float offsetX = 0;
+    float offsetY = 0;
+    for (int i = 0; text[i] != '\0';)
+    {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&text[i], &bytes);
+        i += bytes;
+        if (codepoint == '\n')
+        {
+            offsetX = 0;
+            offsetY += fontSize + TEXT_LINE_SPACING;
+            continue;
+        }
+
+        int index = GetGlyphIndex(font, codepoint);
+        GlyphInfo const &glyph = font.glyphs[index];
+        Rectangle rec = font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t')
+        {
+            DrawQuad *quad = addQuad(layer, font.texture.id, BLEND_ALPHA);
+            if (quad == nullptr)
+                return;
+            Rectangle source = {rec.x - padding, rec.y - padding, rec.width + 2 * padding, rec.height + 2 * padding};
+            Rectangle dest = {position.x + offsetX + (glyph.offsetX - padding) * scale,
+                              position.y + offsetY + (glyph.offsetY - padding) * scale, source.width * scale,
+                              source.height * scale};
+            setCorners(quad, dest);
+            setSource(quad, font.texture, source);
+            quad->color = tint;
+        }
+        offsetX += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + spacing;
+    }
+}
+
+void drawListRing(DrawLayer layer, Vector2 center, float innerRadius, float outerRadius, int segments, Color color)
+{
+    stats.commands++;
+    Texture2D shapes = GetShapesTexture();
+    Rectangle texel = GetShapesTextureRectangle();
+    float cx = center.x + drawOffset.x;
+    float cy = center.y + drawOffset.y;
+    float step = 2 * PI / segments;
+    for (int i = 0; i < segments; i++)
+    {
+        DrawQuad *quad = addQuad(layer, shapes.id, BLEND_ALPHA);
+        if (quad == nullptr)
+            return;
+        float cos0 = cosf(i * step);
+        float sin0 = sinf(i * step);
+        float cos1 = cosf((i + 1) * step);
+        float sin1 = sinf((i + 1) * step);
+        quad->x[0] = cx + cos0 * outerRadius;
+        quad->y[0] = cy + sin0 * outerRadius;
+        quad->x[1] = cx + cos0 * innerRadius;
+        quad->y[1] = cy + sin0 * innerRadius;
+        quad->x[2] = cx + cos1 * innerRadius;
+        quad->y[2] = cy + sin1 * innerRadius;
+        quad->x[3] = cx + cos1 * outerRadius;
+        quad->y[3] = cy + sin1 * outerRadius;
+        setSource(quad, shapes, texel);
+        quad->color = color;
+    }
+}
+
+void drawListCustom(DrawLayer layer, unsigned int texture, int vertices, void (*draw)(void const *data),
+                    void const *data)
+{
+    stats.commands++;
+    DrawQuad *quad = addQuad(layer, texture, BLEND_ALPHA);
+    if (quad == nullptr)
+        return;
+    quad->draw = draw;
+    quad->data = data;
+    quad->vertices = vertices;
+}
+
+void drawListFlush()
+{
+    std::sort(keys, keys + quadCount);
+
+    int blend = BLEND_ALPHA;
+    bool started = false;
+    unsigned int texture = 0;
+    for (int i = 0; i < quadCount; i++)
+    {
+        DrawQuad const &quad = quads[(uint32_t)keys[i]];
+        if (!started || quad.blend != blend || quad.texture != texture)
+        {
+            // A new blend mode draws the batch so far, a new texture starts another draw call within it
+            if (quad.blend != blend)
+            {
+                blend = quad.blend;
+                BeginBlendMode(blend);
+            }
+            texture = quad.texture;
+            started = true;
+            stats.batches++;
+        }
+
+        if (quad.draw != nullptr)
+        {
+            quad.draw(quad.data);
+            stats.vertices += quad.vertices;
+            continue;
+        }
+
+        if (rlCheckRenderBatchLimit(4))
+            stats.batches++;
+        rlSetTexture(texture);
+        rlBegin(RL_QUADS);
+        rlColor4ub(quad.color.r, quad.color.g, quad.color.b, quad.color.a);
+        rlTexCoord2f(quad.u0, quad.v0);
+        rlVertex2f(quad.x[0], quad.y[0]);
+        rlTexCoord2f(quad.u0, quad.v1);
+        rlVertex2f(quad.x[1], quad.y[1]);
+        rlTexCoord2f(quad.u1, quad.v1);
+        rlVertex2f(quad.x[2], quad.y[2]);
+        rlTexCoord2f(quad.u1, quad.v0);
+        rlVertex2f(quad.x[3], quad.y[3]);
+        rlEnd();
+        stats.vertices += 4;
+    }
+    rlSetTexture(0);
+    if (blend != BLEND_ALPHA)
+        EndBlendMode();
+
+    quadCount = 0;
+}
+
+DrawListStats const &drawListStats()
+{
+    return stats;
+}
@@ -0,0 +1,63 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+// Retained draw list: a frame records its rectangles, texture regions and text as quads, and drawListFlush() sorts
+// them by layer, blend mode and texture before handing them to rlgl, so each texture is bound once per layer instead
+// of every time the source order switches between text, shapes and images.
+//
+// Quads keep their recording order within one layer and texture. Quads of different textures in the same layer may
+// be reordered against each other, so anything that has to cover something else goes in a later layer.
+
+#include "raylib.h"
+
+enum DrawLayer
+{
+    LAYER_BACKGROUND, // Board, starfield, menu glows
+    LAYER_SCENE,      // Pieces, sprites, panels behind text
+    LAYER_EFFECTS,    // Particles and pulse rings
+    LAYER_TEXT,       // Everything written
+    DRAW_LAYERS
+};
+
+struct DrawListStats
+{
+    int commands; // Draw calls recorded, a text or a ring being one
+    int batches;  // Draw calls rlgl issued for them: one per blend mode and texture run, plus full vertex buffers
+    int vertices;
+};
+
+// Starts a frame: clears the list and the counters
+void drawListBegin();
+
+// Moves everything recorded afterwards by offset, as a Camera2D offset would
+void drawListOffset(Vector2 offset);
+
+void drawListRectangle(DrawLayer layer, Rectangle rect, Color color);
+
+// Outline drawn inside rect
+void drawListRectangleLines(DrawLayer layer, Rectangle rect, float thickness, Color color);
+
+// Region source of texture stretched over dest. A negative source height reads the region upside down, as render
+// textures need. blend is a raylib BlendMode.
+void drawListTexture(DrawLayer layer, Texture2D texture, Rectangle source, Rectangle dest, Color tint, int blend);
+
+// Lays text out as DrawTextEx does, one quad per visible glyph
+void drawListText(DrawLayer layer, Font font, char const *text, Vector2 position, float fontSize, float spacing,
+                  Color tint);
+
+// Ring between the two radii made of segments quads
+void drawListRing(DrawLayer layer, Vector2 center, float innerRadius, float outerRadius, int segments, Color color);
+
+// Calls draw(data) in the sorted order, for batches that write rlgl vertices themselves. texture is the one draw
+// binds, vertices how many it writes.
+void drawListCustom(DrawLayer layer, unsigned int texture, int vertices, void (*draw)(void const *data),
+                    void const *data);
+
+// Submits everything recorded so far and empties the list. May run more than once a frame, e.g. inside a texture
+// mode, the counters adding up until the next drawListBegin().
+void drawListFlush();
+
+// Counters of the current frame
+DrawListStats const &drawListStats();
+
+#endif // !DRAW_LIST_H
@@ -0,0 +1,51 @@
+#include "frame_pacing.h"
+
+#include <algorithm>
+#include <math.h>
+
+void recordFrameTime(FramePacing &pacing, float frameTime)
+{
+    pacing.frameTimes[pacing.next] = frameTime;
+    pacing.next = (pacing.next + 1) % PACING_WINDOW;
+    if (pacing.count < PACING_WINDOW)
+        pacing.count++;
+}
+
+float frameTimeAt(FramePacing const &pacing, int age)
+{
+    return pacing.frameTimes[(pacing.next - 1 - age + 2 * PACING_WINDOW) % PACING_WINDOW];
+}
+
+PacingStats pacingStats(FramePacing const &pacing, float budget)
+{
+    PacingStats stats = {pacing.count, 0, 0, 0, 0, 0};
+    if (pacing.count == 0)
+        return stats;
+
+    float sorted[PACING_WINDOW];
+    float sum = 0;
+    for (int i = 0; i < pacing.count; i++)
+    {
+        float frameTime = pacing.frameTimes[i];
+        sorted[i] = frameTime;
+        sum += frameTime;
+        if (frameTime > stats.worst)
+            stats.worst = frameTime;
+        if (frameTime > PACING_LATE_FRAME * budget)
+            stats.lateFrames++;
+    }
+    stats.average = sum / pacing.count;
+
+    float variance = 0;
+    for (int i = 0; i < pacing.count; i++)
+    {
+        float deviation = pacing.frameTimes[i] - stats.average;
+        variance += deviation * deviation;
+    }
+    stats.jitter = sqrtf(variance / pacing.count);
+
+    int percentile = pacing.count * 99 / 100;
+    std::nth_element(sorted, sorted + percentile, sorted + pacing.count);
+    stats.percentile99 = sorted[percentile];
+    return stats;
+}
@@ -0,0 +1,38 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+// Frame pacing over the last few seconds: how long frames take on average, how long the slowest ones take and how
+// much they vary, for the overlay that shows whether a high refresh rate is actually being met.
+
+// Frames in the rolling window, one second at 240 fps
+int const PACING_WINDOW = 240;
+
+// A frame this many budgets long missed at least one refresh
+float const PACING_LATE_FRAME = 1.5f;
+
+struct FramePacing
+{
+    float frameTimes[PACING_WINDOW];
+    int next;
+    int count;
+};
+
+struct PacingStats
+{
+    int frames;
+    float average;      // Seconds
+    float percentile99; // Seconds, 1 frame in 100 took longer
+    float worst;        // Seconds
+    float jitter;       // Standard deviation of the frame time, seconds
+    int lateFrames;     // Frames over PACING_LATE_FRAME budgets
+};
+
+void recordFrameTime(FramePacing &pacing, float frameTime);
+
+// Frame time of the age-th newest frame in the window, age 0 being the last one recorded
+float frameTimeAt(FramePacing const &pacing, int age);
+
+// Summarizes the window, budget being the frame time aimed at
+PacingStats pacingStats(FramePacing const &pacing, float budget);
+
+#endif // !FRAME_PACING_H
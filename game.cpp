@@ -0,0 +1,593 @@
+#include "game.h"
+#include "replay.h"
+
+#include <cassert>
+#include <cmath>
+
+
+static float levelFallSpeed(int level)
+{
+    return BASE_FALL_SPEED / (1.0f + (level - 1) * 0.1f);
+}
+
+// Stream id of Game::rng, the piece generator uses its own
+static uint64_t const RULES_STREAM = 2;
+
+static bool checkCollisionRecs(float x1, float y1, float w1, float h1, float x2, float y2, float w2, float h2)
+{
+    return x1 < x2 + w2 && x1 + w1 > x2 && y1 < y2 + h2 && y1 + h1 > y2;
+}
+
+static void spawnPiece(Game &game)
+{
+    Tetromino &piece = game.currentPiece;
+    piece.type = (uint8_t)nextPiece(game.generator);
+    piece.rotation = 0;
+    piece.x = GRID_HORIZONTAL_SIZE / 2;
+    piece.y = 0;
+
+    game.fallTimer = 0.0f;
+    game.isInFreeFall = false;
+    game.fallSpeed = levelFallSpeed(game.level);
+
+    assert(game.currentPiece.pieceState == LOCKED || game.currentPiece.pieceState == NEW);
+    game.currentPiece.pieceState = FALL;
+
+    // A new piece has no previous position to slide from
+    game.previousPiece = game.currentPiece;
+    game.piecesSpawned++;
+}
+
+void newGame(Game &game, uint64_t seed, GeneratorMode mode)
+{
+    game.seed = seed;
+    initGenerator(game.generator, seed, mode);
+    seedRng(game.rng, seed, RULES_STREAM);
+
+    clearBoard(game.board);
+    game.phase = PHASE_PLAYING;
+    game.paused = false;
+    game.tickCount = 0;
+    game.piecesSpawned = 0;
+    game.accumulator = 0.0f;
+    game.pendingPressed = 0;
+    game.score = 0;
+    game.level = 1;
+    game.linesClearedTotal = 0;
+    game.linesClearedThisLevel = 0;
+    game.fallTimer = 0.0f;
+    game.lateralTimer = 0.0f;
+    game.bottomedTimer = 0.0f;
+    game.doorHit = false;
+    game.doorEffectTimer = 0.0f;
+    game.isElectrocuted = false;
+    game.electrocutionTimer = 0.0f;
+    game.transitionTimer = 0.0f;
+    game.events = 0;
+    game.linesCleared = 0;
+    game.recorder = nullptr;
+    game.currentPiece.pieceState = NEW;
+    spawnPiece(game);
+}
+
+static void startLevelTransition(Game &game)
+{
+    game.phase = PHASE_TRANSITION;
+    game.events |= EVENT_LEVEL_UP;
+    game.level++;
+    game.fallSpeed = levelFallSpeed(game.level);
+    clearBoard(game.board);
+    game.score = 0;
+    game.linesClearedThisLevel = 0;
+    game.doorHit = false;
+    game.doorEffectTimer = 0.0f;
+
+    game.player.position = {(float)ARENA_WIDTH - 50, 25.0f};
+    game.previousPlayerPosition = game.player.position;
+    game.player.velocity = {0, 0};
+    game.player.isJumping = false;
+
+    // Initialize platforms
+    float startX = ARENA_WIDTH - game.platforms[0].width;
+    float spacing = 220.0f;
+    for (int i = 0; i < NUM_PLATFORMS; i++)
+    {
+        float platformX = startX - i * spacing;
+        int minY = ARENA_HEIGHT - 250;
+        int maxY = ARENA_HEIGHT - 50;
+        float platformY = (float)randomRange(game.rng, minY, maxY);
+        game.platforms[i].position = {platformX, platformY};
+    }
+
+    Platform const &lastPlatform = game.platforms[NUM_PLATFORMS - 1];
+    game.door.position = {lastPlatform.position.x - game.door.width / 2 - 70,
+                          lastPlatform.position.y - game.door.height / 2 + game.platforms[0].height / 2};
+
+    game.transitionTimer = TRANSITION_DURATION;
+    game.currentPiece.pieceState = NEW;
+    spawnPiece(game);
+}
+
+static void endGame(Game &game)
+{
+    game.phase = PHASE_OVER;
+    game.events |= EVENT_GAME_OVER;
+}
+
+static int checkAndClearLines(Game &game, PieceMask const &locked)
+{
+    int clearedRows[GRID_VERTICAL_SIZE];
+    int linesCleared = clearFullRows(game.board, locked.top, locked.top + PIECE_MASK_ROWS - 1, clearedRows);
+    if (linesCleared > 0)
+        game.events |= EVENT_LINES_CLEARED;
+
+    // Several locks can land in one step, keep every cleared row for the effects
+    for (int i = 0; i < linesCleared && game.linesCleared < GRID_VERTICAL_SIZE; i++)
+    {
+        game.clearedRows[game.linesCleared++] = clearedRows[i];
+    }
+
+    game.score += linesCleared * 10 * game.level;
+    game.linesClearedTotal += linesCleared;
+    game.linesClearedThisLevel += linesCleared;
+
+    if (isBoardEmpty(game.board) && linesCleared > 0)
+    {
+        game.score += 50;
+        game.events |= EVENT_GRID_CLEARED;
+    }
+
+    int linesNeeded = game.level * game.level;
+
+    if (game.linesClearedThisLevel >= linesNeeded)
+    {
+        startLevelTransition(game);
+    }
+    return linesCleared;
+}
+
+static void moveDown(Tetromino &currentPiece)
+{
+    currentPiece.y++;
+}
+
+static void moveHorizontally(Game &game, int amount)
+{
+    if (canMoveHorizontally(game, game.currentPiece, amount))
+        game.currentPiece.x += amount;
+}
+
+static void UpdateGame(Game &game, GameInput const &input, float dt)
+{
+    if (input.pressed & INPUT_PAUSE)
+        game.paused = !game.paused;
+
+    if (game.paused)
+        return;
+
+    if (input.pressed & INPUT_GRID)
+        game.events |= EVENT_TOGGLE_GRID;
+
+    if (input.pressed & INPUT_THEME)
+        game.events |= EVENT_TOGGLE_THEME;
+
+    if (input.pressed & INPUT_SKIP)
+        return startLevelTransition(game);
+
+    if (input.pressed & INPUT_LEFT)
+    {
+        game.lateralTimer += dt;
+        if (game.lateralTimer >= LATERAL_SPEED)
+            moveHorizontally(game, -1);
+    }
+    if (input.pressed & INPUT_RIGHT)
+    {
+        game.lateralTimer += dt;
+        if (game.lateralTimer >= LATERAL_SPEED)
+            moveHorizontally(game, 1);
+    }
+
+    if (input.down & INPUT_LEFT)
+    {
+        game.lateralTimer += dt;
+        if (game.lateralTimer >= LATERAL_SPEED)
+        {
+            game.lateralTimer -= LATERAL_SPEED;
+            moveHorizontally(game, -1);
+        }
+    }
+    else if (input.down & INPUT_RIGHT)
+    {
+        game.lateralTimer += dt;
+        if (game.lateralTimer >= LATERAL_SPEED)
+        {
+            game.lateralTimer -= LATERAL_SPEED;
+            moveHorizontally(game, 1);
+        }
+    }
+    else
+    {
+        game.lateralTimer = 0.0f;
+    }
+
+    if (input.pressed & INPUT_UP)
+    {
+        game.currentPiece = rotatePiece(game.board, game.currentPiece);
+        // Rotations snap, only translations are interpolated
+        game.previousPiece = game.currentPiece;
+    }
+
+    if (input.pressed & INPUT_DOWN)
+    {
+        game.fallSpeed = 0.05f;
+    }
+
+    if (input.pressed & INPUT_SPACE)
+    {
+        game.isInFreeFall = true;
+        game.fallSpeed = 0.01f;
+        // Lands in this tick, the lock delay still follows
+        game.currentPiece = ghostPiece(game.board, game.currentPiece);
+        game.previousPiece = game.currentPiece;
+    }
+
+    Tetromino &currentPiece = game.currentPiece;
+
+    game.fallTimer += dt;
+    if ((currentPiece.pieceState != BOTTOMED && game.fallTimer >= game.fallSpeed) ||
+        currentPiece.pieceState == BOTTOMED)
+    {
+        game.fallTimer = 0.0f;
+
+        if (canMoveDown(game.board, currentPiece))
+        {
+            moveDown(currentPiece);
+            // Slid off a ledge: falls on from here under the fall timer again, not one row per tick
+            if (currentPiece.pieceState == BOTTOMED)
+                currentPiece.pieceState = FALL;
+        }
+        else
+        {
+            if (currentPiece.pieceState == BOTTOMED)
+            {
+                game.bottomedTimer += dt;
+            }
+            else
+            {
+                currentPiece.pieceState = BOTTOMED;
+            }
+
+            // check timer
+            if (game.bottomedTimer < LOCK_DELAY)
+            {
+                return;
+            }
+            else
+            {
+                game.bottomedTimer = 0.0f;
+                currentPiece.pieceState = LOCKED;
+            }
+
+            PieceMask locked = pieceMask(currentPiece);
+            placeMask(game.board, locked);
+            game.events |= EVENT_PIECE_LOCKED;
+
+            checkAndClearLines(game, locked);
+            // TODO don't go here if level up
+            if (game.phase == PHASE_PLAYING)
+            {
+                spawnPiece(game);
+
+                // Check if the new piece overlaps with existing blocks (game over condition)
+                if (collides(game.board, pieceMask(currentPiece))) // New piece can't spawn
+                {
+                    endGame(game);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static void UpdateLevelTransition(Game &game, GameInput const &input, float deltaTime)
+{
+    if (input.pressed & INPUT_PAUSE)
+        game.paused = !game.paused;
+
+    if (game.paused)
+        return;
+
+    if (game.doorHit)
+    {
+        game.currentPiece.pieceState = NEW;
+        game.doorEffectTimer -= deltaTime;
+        if (game.doorEffectTimer <= 0.0f)
+        {
+            game.doorHit = false;
+            game.phase = PHASE_PLAYING;
+            game.events |= EVENT_TRANSITION_DONE;
+            spawnPiece(game);
+        }
+        return;
+    }
+    if (game.isElectrocuted)
+    {
+        game.electrocutionTimer -= deltaTime;
+        if (game.electrocutionTimer <= 0.0f)
+        {
+            game.isElectrocuted = false;
+            endGame(game);
+        }
+        return;
+    }
+
+    Player &player = game.player;
+
+    const float GRAVITY = 500.0f;
+    player.velocity.y += GRAVITY * deltaTime;
+
+    const float MOVE_SPEED = 200.0f;
+    if (input.down & INPUT_LEFT)
+    {
+        player.velocity.x = -MOVE_SPEED;
+    }
+    else if (input.down & INPUT_RIGHT)
+    {
+        player.velocity.x = MOVE_SPEED;
+    }
+    else
+    {
+        player.velocity.x = 0;
+    }
+
+    if ((input.pressed & INPUT_SPACE) && !player.isJumping)
+    {
+        player.velocity.y = -450.0f;
+        player.isJumping = true;
+    }
+    else if (input.pressed & INPUT_SKIP)
+    {
+        game.phase = PHASE_PLAYING;
+        game.events |= EVENT_TRANSITION_DONE;
+        game.currentPiece.pieceState = NEW;
+    }
+
+    player.position.x += player.velocity.x * deltaTime;
+    player.position.y += player.velocity.y * deltaTime;
+
+    float boundingWidth = 24.0f;
+    float boundingHeight = 50.0f;
+    if (player.position.x - boundingWidth / 2 < 0 || player.position.x + boundingWidth / 2 > ARENA_WIDTH)
+    {
+        game.isElectrocuted = true;
+        game.electrocutionTimer = ELECTROCUTION_DURATION;
+        game.events |= EVENT_ELECTROCUTED;
+        return;
+    }
+
+    float playerX = player.position.x - boundingWidth / 2;
+    float playerY = player.position.y - boundingHeight / 2;
+
+    for (int i = 0; i < NUM_PLATFORMS; i++)
+    {
+        Platform const &platform = game.platforms[i];
+
+        if (checkCollisionRecs(playerX, playerY, boundingWidth, boundingHeight, platform.position.x,
+                               platform.position.y, platform.width, platform.height))
+        {
+            float dx = (playerX + boundingWidth / 2) - (platform.position.x + platform.width / 2);
+            float dy = (playerY + boundingHeight / 2) - (platform.position.y + platform.height / 2);
+            float overlapX = fabsf(dx) - (boundingWidth / 2 + platform.width / 2);
+            float overlapY = fabsf(dy) - (boundingHeight / 2 + platform.height / 2);
+
+            if (overlapX < 0 && overlapY < 0)
+            {
+                if (fabsf(overlapX) < fabsf(overlapY))
+                {
+                    if (dx > 0)
+                    {
+                        player.position.x = platform.position.x + platform.width + boundingWidth / 2;
+                    }
+                    else
+                    {
+                        player.position.x = platform.position.x - boundingWidth / 2;
+                    }
+                    player.velocity.x = 0;
+                }
+                else
+                {
+                    if (dy > 0)
+                    {
+                        player.position.y = platform.position.y + platform.height + boundingHeight / 2;
+                        player.velocity.y = 0; // Stop vertical movement
+                    }
+                    else if (dy < 0 && player.velocity.y > 0)
+                    {
+                        player.position.y = platform.position.y - boundingHeight / 2;
+                        player.velocity.y = 0;
+                        player.isJumping = false;
+                    }
+                }
+            }
+        }
+
+        Door const &door = game.door;
+        if (checkCollisionRecs(playerX, playerY, boundingWidth, boundingHeight, door.position.x, door.position.y,
+                               door.width, door.height))
+        {
+            game.doorHit = true;
+            game.doorEffectTimer = DOOR_EFFECT_DURATION;
+            game.events |= EVENT_DOOR_HIT;
+            return;
+        }
+
+        if (player.position.y - boundingHeight / 2 > ARENA_HEIGHT)
+        {
+            endGame(game);
+            return;
+        }
+    }
+
+    game.transitionTimer -= deltaTime;
+    if (game.transitionTimer <= 0.0f)
+    {
+        endGame(game);
+    }
+}
+
+static void runTick(Game &game, GameInput const &input)
+{
+    if (game.recorder)
+        recordTick(*game.recorder, game.tickCount, input);
+
+    game.previousPiece = game.currentPiece;
+    game.previousPlayerPosition = game.player.position;
+    game.tickCount++;
+
+    switch (game.phase)
+    {
+    case PHASE_PLAYING:
+        UpdateGame(game, input, SIM_DT);
+        break;
+    case PHASE_TRANSITION:
+        UpdateLevelTransition(game, input, SIM_DT);
+        break;
+    case PHASE_OVER:
+        break;
+    }
+}
+
+void step(Game &game, GameInput const &input, float dt)
+{
+    game.events = 0;
+    game.linesCleared = 0;
+
+    if (dt > MAX_FRAME_TIME)
+        dt = MAX_FRAME_TIME;
+    game.accumulator += dt;
+
+    GameInput tickInput = {input.down, (uint16_t)(input.pressed | game.pendingPressed)};
+    game.pendingPressed = tickInput.pressed;
+
+    while (game.accumulator >= SIM_DT)
+    {
+        game.accumulator -= SIM_DT;
+        runTick(game, tickInput);
+
+        // A press happens once, later ticks of the same step only see the buttons held
+        tickInput.pressed = 0;
+        game.pendingPressed = 0;
+    }
+}
+
+void tick(Game &game, GameInput const &input)
+{
+    game.events = 0;
+    game.linesCleared = 0;
+    runTick(game, input);
+}
+
+static uint64_t hashBytes(uint64_t hash, void const *data, size_t size)
+{
+    // FNV-1a
+    unsigned char const *bytes = (unsigned char const *)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+uint64_t hashGame(Game const &game)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    hash = hashBytes(hash, game.board.rows, sizeof(game.board.rows));
+    Tetromino const &piece = game.currentPiece;
+    int32_t const counters[] = {(int32_t)game.phase, (int32_t)piece.pieceState, piece.x, piece.y, piece.type,
+                                piece.rotation, (int32_t)game.tickCount, game.score, game.level,
+                                game.linesClearedTotal, game.linesClearedThisLevel};
+    hash = hashBytes(hash, counters, sizeof(counters));
+    hash = hashBytes(hash, &game.player.position, sizeof(Vec2));
+    return hash;
+}
+
+float interpolationAlpha(Game const &game)
+{
+    return game.accumulator / SIM_DT;
+}
+
+float fallProgress(Game const &game, float alpha)
+{
+    Tetromino const &piece = game.currentPiece;
+    if (game.phase != PHASE_PLAYING || piece.pieceState == BOTTOMED || !canMoveDown(game.board, piece))
+        return 0.0f;
+
+    // The fall timer stands still while paused
+    float fallTime = game.fallTimer + (game.paused ? 0.0f : alpha * SIM_DT);
+    float progress = fallTime / game.fallSpeed;
+    return progress < 1.0f ? progress : 1.0f;
+}
+
+PieceMask pieceMask(Tetromino const &piece)
+{
+    return shapeMask(pieceShape(piece.type, piece.rotation), piece.x, piece.y);
+}
+
+Tetromino ghostPiece(Board const &board, Tetromino const &piece)
+{
+    Tetromino ghost = piece;
+    ghost.y += dropDistance(board, pieceShape(piece.type, piece.rotation), piece.x, piece.y);
+    return ghost;
+}
+
+bool canMoveHorizontally(Game const &game, Tetromino const &currentPiece, int amount)
+{
+    if (game.isInFreeFall && currentPiece.pieceState != BOTTOMED)
+    {
+        return false;
+    }
+
+    // No lateral movement if touching ground
+    PieceShape const &shape = pieceShape(currentPiece.type, currentPiece.rotation);
+    if (currentPiece.pieceState != BOTTOMED && currentPiece.y + shape.top + shape.height >= GRID_VERTICAL_SIZE)
+    {
+        return false;
+    }
+
+    // check X against the walls and the locked blocks in one pass over the row masks
+    return !collides(game.board, pieceMask(currentPiece), amount, 0);
+}
+
+Tetromino rotatePiece(Board const &board, Tetromino const &piece)
+{
+    int rotation = (piece.rotation + 1) & (PIECE_ORIENTATIONS - 1);
+    PieceShape const &shape = pieceShape(piece.type, rotation);
+    KickTable const &kicks = WALL_KICKS[piece.type];
+    int x = piece.x;
+    int y = piece.y;
+
+    // Just below the ceiling a turn that would poke out of the grid pushes the piece down instead
+    if (y + shape.top < 0)
+        y = -shape.top;
+
+    for (int i = 0; i < kicks.count; i++)
+    {
+        int kickedX = x + kicks.offsets[i][0];
+        int kickedY = y + kicks.offsets[i][1];
+        if (shapeFits(shape, kickedX, kickedY) && !collides(board, shapeMask(shape, kickedX, kickedY)))
+        {
+            Tetromino rotated = piece;
+            rotated.x = (int8_t)kickedX;
+            rotated.y = (int8_t)kickedY;
+            rotated.rotation = (uint8_t)rotation;
+            return rotated;
+        }
+    }
+    return piece;
+}
+
+bool canMoveDown(Board const &board, Tetromino const &piece)
+{
+    return !collides(board, pieceMask(piece), 0, 1);
+}
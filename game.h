@@ -0,0 +1,199 @@
+#ifndef GAME_H
+#define GAME_H
+
+// Headless simulation core (libtetriscore): grid, pieces, spawning, line clears, levels, scoring
+// and the level transition minigame. No window, GL or audio dependency.
+
+#include "board.h"
+#include "generator.h"
+#include "pieces.h"
+#include "rng.h"
+
+#include <stdint.h>
+
+// Size of the level transition arena in pixels (the front-end window size)
+int const ARENA_WIDTH = 1150;
+int const ARENA_HEIGHT = 594;
+
+// The simulation advances in fixed ticks, independent of the display frame rate
+int const SIM_TICK_RATE = 240;
+float const SIM_DT = 1.0f / SIM_TICK_RATE;
+float const MAX_FRAME_TIME = 0.25f; // Longer hitches are dropped instead of replayed tick by tick
+
+int const NUM_PLATFORMS = 5;
+
+float const BASE_FALL_SPEED = 0.3f;
+float const LATERAL_SPEED = 0.07f;
+float const LOCK_DELAY = 0.15f;
+float const TRANSITION_DURATION = 10.0f;
+float const DOOR_EFFECT_DURATION = 1.0f;
+float const ELECTROCUTION_DURATION = 2.0f;
+
+struct Vec2
+{
+    float x;
+    float y;
+};
+
+enum PieceState : uint8_t
+{
+    NEW,
+    FALL,
+    FREE_FALL,
+    BOTTOMED,
+    LOCKED
+};
+
+// A piece is its pivot cell and an orientation, its cells are PIECE_SHAPES[type][rotation] around the pivot.
+// Integer cells keep the rules exact on every compiler, floats only appear when the front-end draws.
+struct Tetromino
+{
+    int8_t x = 0;
+    int8_t y = 0;
+    uint8_t type = PIECE_I;
+    uint8_t rotation = 0;
+    PieceState pieceState = NEW;
+};
+
+struct Player
+{
+    Vec2 position;
+    Vec2 velocity;
+    bool isJumping = false;
+};
+
+struct Platform
+{
+    Vec2 position;
+    float width = 100.0f;
+    float height = 20.0f;
+};
+
+struct Door
+{
+    Vec2 position;
+    float width = 55.0f;
+    float height = 120.0f;
+};
+
+// Buttons of a GameInput, one bit each
+enum InputButton
+{
+    INPUT_LEFT = 1 << 0,
+    INPUT_RIGHT = 1 << 1,
+    INPUT_UP = 1 << 2,
+    INPUT_DOWN = 1 << 3,
+    INPUT_SPACE = 1 << 4,
+    INPUT_PAUSE = 1 << 5, // P
+    INPUT_GRID = 1 << 6,  // G
+    INPUT_THEME = 1 << 7, // T
+    INPUT_SKIP = 1 << 8   // C
+};
+
+struct GameInput
+{
+    uint16_t down;    // Buttons held this step
+    uint16_t pressed; // Buttons that went down this step
+};
+
+enum GamePhase
+{
+    PHASE_PLAYING,
+    PHASE_TRANSITION,
+    PHASE_OVER
+};
+
+// What happened during the last step, for the front-end to react to (effects, sounds, screens)
+enum GameEvent
+{
+    EVENT_LINES_CLEARED = 1 << 0,   // linesCleared / clearedRows are valid
+    EVENT_GRID_CLEARED = 1 << 1,    // The +50 empty grid bonus was awarded
+    EVENT_LEVEL_UP = 1 << 2,        // The level transition minigame started
+    EVENT_DOOR_HIT = 1 << 3,        // The player reached the door
+    EVENT_ELECTROCUTED = 1 << 4,    // The player touched a wall
+    EVENT_TRANSITION_DONE = 1 << 5, // Back to the Tetris board
+    EVENT_GAME_OVER = 1 << 6,
+    EVENT_TOGGLE_GRID = 1 << 7,
+    EVENT_TOGGLE_THEME = 1 << 8,
+    EVENT_PIECE_LOCKED = 1 << 9 // The board changed under the falling piece
+};
+
+struct ReplayWriter;
+
+struct Game
+{
+    Board board;
+    Tetromino currentPiece;
+    Tetromino previousPiece; // currentPiece as it was before the last tick, for interpolated drawing
+    GamePhase phase;
+    bool paused;
+
+    uint64_t seed;
+    PieceGenerator generator; // Piece sequence, its own stream of the seed
+    Rng rng;                  // Everything else random in the rules (platform heights)
+
+    uint32_t tickCount;      // Fixed ticks simulated so far
+    uint32_t piecesSpawned;  // Pieces dealt so far, including the current one
+    float accumulator;       // Frame time not yet simulated, always below SIM_DT after a step
+    uint16_t pendingPressed; // Presses seen by a step that ran no tick, delivered with the next one
+
+    int score;
+    int level;
+    int linesClearedTotal;
+    int linesClearedThisLevel;
+
+    float fallSpeed;
+    float fallTimer;
+    float lateralTimer;
+    float bottomedTimer;
+    bool isInFreeFall;
+
+    // Level transition
+    Player player;
+    Vec2 previousPlayerPosition;
+    Platform platforms[NUM_PLATFORMS];
+    Door door;
+    float transitionTimer;
+    bool doorHit;
+    float doorEffectTimer;
+    bool isElectrocuted;
+    float electrocutionTimer;
+
+    ReplayWriter *recorder; // Receives every tick's input while a replay is being recorded
+
+    // Output of the last step, accumulated over all of its ticks
+    unsigned int events;
+    int linesCleared;
+    int clearedRows[GRID_VERTICAL_SIZE];
+};
+
+// Resets the game to level 1 with an empty board and a falling piece. The same seed and mode always
+// replay the same game for the same inputs.
+void newGame(Game &game, uint64_t seed, GeneratorMode mode = GENERATOR_RANDOM);
+
+// Advances the game by dt seconds of real time: runs as many fixed ticks as the accumulated time
+// allows and keeps the remainder for the next step. Presses are delivered to the first tick.
+void step(Game &game, GameInput const &input, float dt);
+
+// Runs exactly one fixed tick of SIM_DT seconds, for headless callers that go faster than real time
+void tick(Game &game, GameInput const &input);
+
+// How far the accumulator is into the next tick, in [0, 1), for interpolating between ticks
+float interpolationAlpha(Game const &game);
+
+// How far the falling piece is on its way down to the next row, in [0, 1], alpha being interpolationAlpha() or
+// the like. 0 while the piece rests on something, so gravity can be drawn as a glide instead of a row at a time.
+float fallProgress(Game const &game, float alpha);
+
+// Hash of everything that decides how the game goes on, to check that two runs ended identically
+uint64_t hashGame(Game const &game);
+
+PieceMask pieceMask(Tetromino const &piece);
+
+// The piece moved straight down as far as it can fall: where a hard drop lands it, the ghost position
+Tetromino ghostPiece(Board const &board, Tetromino const &piece);
+bool canMoveHorizontally(Game const &game, Tetromino const &piece, int amount);
+bool canMoveDown(Board const &board, Tetromino const &piece);
+Tetromino rotatePiece(Board const &board, Tetromino const &piece);
+
+#endif // !GAME_H
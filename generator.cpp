@@ -0,0 +1,71 @@
+#include "generator.h"
+
+// Stream id of the piece sequence, so other users of the same seed get unrelated numbers
+static uint64_t const PIECE_STREAM = 1;
+
+static void push(PieceGenerator &generator, int piece)
+{
+    generator.queue[(generator.head + generator.count) & (PIECE_QUEUE_SIZE - 1)] = (uint8_t)piece;
+    generator.count++;
+}
+
+static void pushBag(PieceGenerator &generator, int copies)
+{
+    uint8_t bag[TOTAL_PIECES_TYPES * 2];
+    int size = TOTAL_PIECES_TYPES * copies;
+    for (int i = 0; i < size; i++)
+    {
+        bag[i] = (uint8_t)(i % TOTAL_PIECES_TYPES);
+    }
+
+    // Fisher-Yates
+    for (int i = size - 1; i > 0; i--)
+    {
+        int j = (int)randomBelow(generator.rng, (uint32_t)(i + 1));
+        uint8_t temp = bag[i];
+        bag[i] = bag[j];
+        bag[j] = temp;
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        push(generator, bag[i]);
+    }
+}
+
+static void refill(PieceGenerator &generator)
+{
+    while (generator.count < MAX_PIECE_PREVIEW)
+    {
+        switch (generator.mode)
+        {
+        case GENERATOR_RANDOM:
+            push(generator, (int)randomBelow(generator.rng, TOTAL_PIECES_TYPES));
+            break;
+        case GENERATOR_BAG_7:
+            pushBag(generator, 1);
+            break;
+        case GENERATOR_BAG_14:
+            pushBag(generator, 2);
+            break;
+        }
+    }
+}
+
+void initGenerator(PieceGenerator &generator, uint64_t seed, GeneratorMode mode)
+{
+    seedRng(generator.rng, seed, PIECE_STREAM);
+    generator.mode = mode;
+    generator.head = 0;
+    generator.count = 0;
+    refill(generator);
+}
+
+PieceType nextPiece(PieceGenerator &generator)
+{
+    PieceType piece = (PieceType)generator.queue[generator.head];
+    generator.head = (uint8_t)((generator.head + 1) & (PIECE_QUEUE_SIZE - 1));
+    generator.count--;
+    refill(generator);
+    return piece;
+}
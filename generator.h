@@ -0,0 +1,54 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+// Deterministic piece sequence: a seeded PRNG feeding a lookahead queue, so the same seed and mode
+// always deal the same pieces (replays, bots, benchmarks) and the next pieces can be peeked in O(1).
+
+#include "rng.h"
+
+#include <stdint.h>
+
+enum PieceType
+{
+    PIECE_I,
+    PIECE_J,
+    PIECE_L,
+    PIECE_O,
+    PIECE_S,
+    PIECE_T,
+    PIECE_Z
+};
+
+int const TOTAL_PIECES_TYPES = 7;
+
+enum GeneratorMode
+{
+    GENERATOR_RANDOM, // Every piece independently uniform
+    GENERATOR_BAG_7,  // Each run of 7 pieces is a shuffle of all seven types
+    GENERATOR_BAG_14  // Each run of 14 pieces is a shuffle of two of each type
+};
+
+int const PIECE_QUEUE_SIZE = 32; // Power of two, holds the preview plus one refill bag
+int const MAX_PIECE_PREVIEW = 16;
+
+struct PieceGenerator
+{
+    Rng rng;
+    GeneratorMode mode;
+    uint8_t queue[PIECE_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t count;
+};
+
+void initGenerator(PieceGenerator &generator, uint64_t seed, GeneratorMode mode);
+
+// Removes and returns the next piece
+PieceType nextPiece(PieceGenerator &generator);
+
+// The piece that nextPiece will return after n more calls, n < MAX_PIECE_PREVIEW
+inline PieceType peekPiece(PieceGenerator const &generator, int n)
+{
+    return (PieceType)generator.queue[(generator.head + n) & (PIECE_QUEUE_SIZE - 1)];
+}
+
+#endif // !GENERATOR_H
@@ -0,0 +1,153 @@
+// tetris-langpack: compiles a language pack source into the file the game memory-maps.
+// Usage: tetris-langpack SOURCE OUTPUT
+//        tetris-langpack --template en|pt|de
+// A source has one "STRING_NAME = text" line per string, '#' starting a comment line. --template prints the
+// source of a built-in language to start a translation from.
+
+#include "localization.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static int printTemplate(char const *code)
+{
+    char const *const CODES[BUILTIN_LANGUAGES] = {"en", "pt", "de"};
+    for (int language = 0; language < BUILTIN_LANGUAGES; language++)
+    {
+        if (strcmp(code, CODES[language]) != 0)
+            continue;
+        printf("# Language pack source, compile with tetris-langpack SOURCE OUTPUT\n");
+        for (int id = 0; id < STRING_COUNT; id++)
+        {
+            printf("%s = %s\n", STRING_NAMES[id], BUILTIN_STRINGS[language][id]);
+        }
+        return 0;
+    }
+    printf("Unknown language %s\n", code);
+    return 2;
+}
+
+static void appendU32(std::vector<uint8_t> &out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        out.push_back((uint8_t)(value >> (i * 8)));
+    }
+}
+
+static int findString(char const *name)
+{
+    for (int id = 0; id < STRING_COUNT; id++)
+    {
+        if (strcmp(name, STRING_NAMES[id]) == 0)
+            return id;
+    }
+    return -1;
+}
+
+static int compilePack(char const *sourcePath, char const *outputPath)
+{
+    FILE *source = fopen(sourcePath, "r");
+    if (!source)
+    {
+        printf("%s: cannot read\n", sourcePath);
+        return 1;
+    }
+
+    std::string texts[STRING_COUNT];
+    bool present[STRING_COUNT] = {};
+    int errors = 0;
+    char line[1024];
+    for (int lineNumber = 1; fgets(line, sizeof(line), source); lineNumber++)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[strspn(line, " \t")] == '\0')
+            continue;
+
+        char *equals = strchr(line, '=');
+        if (!equals)
+        {
+            printf("%s:%d: expected NAME = text\n", sourcePath, lineNumber);
+            errors++;
+            continue;
+        }
+        char *nameEnd = equals;
+        while (nameEnd > line && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t'))
+            nameEnd--;
+        *nameEnd = '\0';
+        char const *text = equals + 1;
+        if (*text == ' ')
+            text++;
+
+        int id = findString(line);
+        if (id < 0)
+        {
+            printf("%s:%d: unknown string %s\n", sourcePath, lineNumber, line);
+            errors++;
+        }
+        else if (!sameConversions(text, BUILTIN_STRINGS[ENGLISH][id]))
+        {
+            printf("%s:%d: %s must keep the conversions of \"%s\"\n", sourcePath, lineNumber, line,
+                   BUILTIN_STRINGS[ENGLISH][id]);
+            errors++;
+        }
+        else
+        {
+            texts[id] = text;
+            present[id] = true;
+        }
+    }
+    fclose(source);
+    if (errors > 0)
+        return 1;
+
+    std::vector<uint8_t> pack;
+    pack.insert(pack.end(), "TSLP", "TSLP" + 4);
+    appendU32(pack, LANGUAGE_PACK_VERSION);
+    appendU32(pack, STRING_COUNT);
+    pack.resize(pack.size() + STRING_COUNT * 4);
+    int missing = 0;
+    for (int id = 0; id < STRING_COUNT; id++)
+    {
+        if (!present[id])
+        {
+            missing++;
+            continue;
+        }
+        uint32_t offset = (uint32_t)pack.size();
+        for (int i = 0; i < 4; i++)
+        {
+            pack[12 + id * 4 + i] = (uint8_t)(offset >> (i * 8));
+        }
+        pack.insert(pack.end(), texts[id].begin(), texts[id].end());
+        pack.push_back('\0');
+    }
+    // The loader requires a final NUL even when no string is present
+    pack.push_back('\0');
+
+    FILE *output = fopen(outputPath, "wb");
+    if (!output || fwrite(pack.data(), 1, pack.size(), output) != pack.size())
+    {
+        printf("%s: cannot write\n", outputPath);
+        if (output)
+            fclose(output);
+        return 1;
+    }
+    fclose(output);
+    printf("%s: %d strings, %d missing (shown in English), %d bytes\n", outputPath, STRING_COUNT - missing, missing,
+           (int)pack.size());
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "--template") == 0)
+        return printTemplate(argv[2]);
+    if (argc == 3)
+        return compilePack(argv[1], argv[2]);
+
+    printf("Usage: %s SOURCE OUTPUT\n       %s --template en|pt|de\n", argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,155 @@
+#include "localization.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+char const *const STRING_NAMES[STRING_COUNT] = {
+#define STRING_NAME(id, english, portuguese, german) #id,
+    LOCALIZED_STRINGS(STRING_NAME)
+#undef STRING_NAME
+};
+
+static uint32_t const HEADER_SIZE = 12;
+
+// The mapped file and, resolved once at load, a pointer into it for every id
+static void const *packData = nullptr;
+static size_t packSize = 0;
+static char const *packStrings[STRING_COUNT];
+
+static void *mapFile(char const *path, size_t &size)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+    LARGE_INTEGER fileSize;
+    void *data = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping)
+        {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        size = (size_t)fileSize.QuadPart;
+    }
+    CloseHandle(file);
+    return data;
+#else
+    int file = open(path, O_RDONLY);
+    if (file < 0)
+        return nullptr;
+    struct stat status;
+    void *data = nullptr;
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+            data = nullptr;
+        size = (size_t)status.st_size;
+    }
+    close(file);
+    return data;
+#endif
+}
+
+static void unmapFile(void const *data, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap((void *)data, size);
+#endif
+}
+
+static uint32_t readU32(uint8_t const *bytes)
+{
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+bool loadLanguagePack(char const *path)
+{
+    size_t size = 0;
+    void *data = mapFile(path, size);
+    if (!data)
+        return false;
+
+    // Every string must end inside the file, which a final NUL guarantees
+    uint8_t const *bytes = (uint8_t const *)data;
+    uint32_t count = size >= HEADER_SIZE ? readU32(bytes + 8) : 0;
+    if (size < HEADER_SIZE || memcmp(bytes, "TSLP", 4) != 0 || readU32(bytes + 4) != LANGUAGE_PACK_VERSION ||
+        count > (size - HEADER_SIZE) / 4 || bytes[size - 1] != '\0')
+    {
+        unmapFile(data, size);
+        return false;
+    }
+
+    unloadLanguagePack();
+    packData = data;
+    packSize = size;
+    uint32_t tableEnd = HEADER_SIZE + count * 4;
+    for (int id = 0; id < STRING_COUNT; id++)
+    {
+        char const *english = BUILTIN_STRINGS[ENGLISH][id];
+        uint32_t offset = (uint32_t)id < count ? readU32(bytes + HEADER_SIZE + id * 4) : 0;
+        char const *text = (char const *)bytes + offset;
+        // A translation may not change what TextFormat reads from its arguments
+        packStrings[id] = offset >= tableEnd && offset < size && sameConversions(text, english) ? text : english;
+    }
+    return true;
+}
+
+void unloadLanguagePack()
+{
+    if (packData)
+        unmapFile(packData, packSize);
+    packData = nullptr;
+    packSize = 0;
+}
+
+char const *packString(StringId id)
+{
+    return packData ? packStrings[id] : BUILTIN_STRINGS[ENGLISH][id];
+}
+
+// Next conversion of a printf format at or after text, as its length from the '%', or 0 at the end
+static char const *nextConversion(char const *text, size_t &length)
+{
+    for (text = strchr(text, '%'); text; text = strchr(text + 2, '%'))
+    {
+        if (text[1] == '%')
+            continue;
+        // An unterminated conversion runs to the end of the text
+        size_t flags = strcspn(text + 1, "diouxXeEfFgGaAcspn");
+        length = text[1 + flags] ? flags + 2 : flags + 1;
+        return text;
+    }
+    length = 0;
+    return nullptr;
+}
+
+bool sameConversions(char const *a, char const *b)
+{
+    size_t lengthA;
+    size_t lengthB;
+    a = nextConversion(a, lengthA);
+    b = nextConversion(b, lengthB);
+    while (a && b)
+    {
+        if (lengthA != lengthB || strncmp(a, b, lengthA) != 0)
+            return false;
+        a = nextConversion(a + lengthA, lengthA);
+        b = nextConversion(b + lengthB, lengthB);
+    }
+    return !a && !b;
+}
@@ -0,0 +1,144 @@
+#ifndef LOCALIZATION_H
+#define LOCALIZATION_H
+
+// All on-screen text, looked up by (language, string id). The built-in languages are a compile-time table; any
+// other language comes from a language pack, a file that is memory-mapped and indexed by string id.
+//
+// Language pack layout, little-endian:
+//   char magic[4]            "TSLP"
+//   uint32_t version         LANGUAGE_PACK_VERSION
+//   uint32_t count           Number of offsets, may differ from STRING_COUNT for packs of another build
+//   uint32_t offsets[count]  Byte offset of string id from the start of the file, 0 if the pack lacks it
+//   NUL-terminated UTF-8 strings
+
+#include <stdint.h>
+
+enum Language
+{
+    ENGLISH,
+    PORTUGUESE,
+    GERMAN,
+    BUILTIN_LANGUAGES,
+    LANGUAGE_PACK = BUILTIN_LANGUAGES // The pack mapped by loadLanguagePack
+};
+
+uint32_t const LANGUAGE_PACK_VERSION = 1;
+
+// Id, English, Portuguese, German. Ids are the index into language packs, so strings are only ever appended.
+// Strings with printf conversions keep them in the same order in every language.
+#define LOCALIZED_STRINGS(X)                                                                                           \
+    X(STR_LANGUAGE_CHOICE, "Choose the language:", "Selecao da lingua:", "Waehle die Sprache:")                        \
+    X(STR_WELCOME, "Welcome to TETRIS SPECIAL", "Bem-vindo ao TETRIS ESPECIAL", "Willkommen bei TETRIS SPECIAL")       \
+    X(STR_START_PROMPT, "Press <ENTER> to Start", "Pressione <ENTER> para Iniciar", "Druecke <ENTER> zum Starten")     \
+    X(STR_MANUAL_PROMPT, "Press <SPACE> to go to the Manual",                                                          \
+      "Pressione <ESPACO> para ver Manual",                                                                            \
+      "Druecke <LEERTASTE> um das Handbuch zu sehen")                                                                  \
+    X(STR_RULES_PROMPT, "Press <R> to go to the Rules",                                                                \
+      "Pressione <R> para ver as Regras",                                                                              \
+      "Duecke <R> um das Regelbuch zu sehen")                                                                          \
+    X(STR_HOME_HINT, "(You can always press <H> to go back to this Menu)",                                             \
+      "(Pode sempre pressionar <H> para voltar a este menu)",                                                          \
+      "(Man kann jederzeit auf <H> druecken, um zurueck zu diesem Menu zu kommen)")                                    \
+    X(STR_SOUND, "Sound:", "Som:", "Ton:")                                                                             \
+    X(STR_SOUND_ON, "ON", "LIGADO", "AN")                                                                              \
+    X(STR_SOUND_OFF, "OFF", "DESLIGADO", "AUS")                                                                        \
+    X(STR_MANUAL_TITLE, "User Manual", "Manual do Usuario", "Benutzerhandbuch")                                        \
+    X(STR_MANUAL_PLAY, "(Press ENTER to Play)", "(Pressione ENTER para Jogar)", "(Druecke ENTER zum Spielen)")         \
+    X(STR_TETRIS_HEADING, "Tetris:", "Tetris:", "Tetris:")                                                             \
+    X(STR_MOVE, "Use arrows to move", "Use setas para mover", "Pfeiltasten zum Bewegen verwenden")                     \
+    X(STR_ROTATE, "Press <UP> to rotate", "Pressione <CIMA> para girar", "Druecke <HOCH> zum Drehen")                  \
+    X(STR_FALL, "Press <DOWN> for fast fall and <SPACE> for free fall",                                                \
+      "Pressione <BAIXO> para queda rapida e <ESPACO> para queda livre",                                               \
+      "Druecke <RUNTER> fuer schnelles Fallen und <LEERTASTE> fuer freien Fall")                                       \
+    X(STR_GRID_TOGGLE, "Press <G> to make the grid disappear or the other way around",                                 \
+      "Pressione <G> para fazer o tabuleiro desaparecer ou vice-versa",                                                \
+      "Druecke <G> um das Gitternetz verschwinden zu lassen oder andersherum")                                         \
+    X(STR_MANUAL_PLAYER_GAME, "Player Game:", "Jogo do Jogador:", "Spielerspiel:")                                     \
+    X(STR_JUMP, "Use <SPACE> to jump", "Use <ESPACO> para pular", "Verwende <LEERTASTE> zum Springen")                 \
+    X(STR_MANUAL_DOOR, "Move the player against the door to pass the level",                                           \
+      "Move o jogador contra a porta para passar de nivel",                                                            \
+      "Bewege den Spieler gegen die Tuer, um das Level zu bestehen")                                                   \
+    X(STR_TIME_LIMIT, "You only have a limited time to move the player against the door(10s)",                         \
+      "So tem um tempo limitado para mover o jogador contra a porta (10s)",                                            \
+      "Man hat nur eine begrenzte Zeit den Spieler gegen die Tuer zu bewegen(10s) ")                                   \
+    X(STR_RULES_TITLE, "Rules", "Regras", "Regeln")                                                                    \
+    X(STR_RULES_PLAY, "(Press ENTER to play)", "(Pressione ENTER para Jogar)", "(Druecke Enter zum Spielen)")          \
+    X(STR_FULL_LINES, "If a line is full it's deleted",                                                                \
+      "Se uma linha inteira estiver cheia, ela sera removida",                                                         \
+      "Wenn eine ganze Linie voll ist, wird sie geloescht")                                                            \
+    X(STR_GRID_FULL, "If your Tetrominos are stacked to high, you die",                                                \
+      "Se os Tetrominos ja nao caberem no tabuleiro, morreras",                                                        \
+      "Wenn die Tetrominos nicht mehr ins Feld passen verlierst du")                                                   \
+    X(STR_RULES_PLAYER_GAME, "Player Game:", "Jogo do Jogador:", "Spielerspiel")                                       \
+    X(STR_FALL_DEATH, "If the player falls between the platforms you die",                                             \
+      "Se caires entra as plataformas, morreras",                                                                      \
+      "Wenn du zwischen die Platformen faellst stirbst du")                                                            \
+    X(STR_WALL_DEATH, "If you move the player against the walls you'll die",                                           \
+      "Se moveres o jogador contra as paredes, morreras",                                                              \
+      "Wenn du den Spieler gegen die Waende bewegst stirbst du")                                                       \
+    X(STR_RULES_DOOR, "Move the player against the door to pass the level",                                            \
+      "Mova o jogador contra a porta para passar de nivel",                                                            \
+      "Bewege den Spieler gegen die Tuer, um das Level zu bestehen")                                                   \
+    X(STR_SCORE, "Score: %i", "Pontuacao: %i", "Punkte: %i")                                                           \
+    X(STR_LEVEL, "Level: %i", "Nivel: %i", "Stufe: %i")                                                                \
+    X(STR_LINES, "Lines: %i", "Linhas: %i", "Linien: %i")                                                              \
+    X(STR_NEXT_LEVEL, "Next Level: %i/%i lines", "Proximo Nivel: %i/%i linhas", "Naechste Stufe: %i/%i Linien")        \
+    X(STR_ADVANCE, "Clear lines to advance!", "Limpe linhas para avancar!", "Loesche Linien zum Fortfahren!")          \
+    X(STR_LEVEL_UP, "Level Up!", "Subir de Nivel!", "Stufe Aufstieg!")                                                 \
+    X(STR_GRID_BONUS, "+50 Grid Clear Bonus!", "+50 Bonus de Limpeza de tabuleiro!", "+50 Bonus fuer Gitterloesung!")  \
+    X(STR_PAUSED, "GAME PAUSED", "JOGO PAUSADO", "SPIEL PAUSIERT")                                                     \
+    X(STR_GAME_OVER, "Game Over", "Fim de Jogo", "Spiel Ende")                                                         \
+    X(STR_TIME_LEFT, "Time Left: %.1f", "Tempo Restante: %.1f", "Verbleibende Zeit: %.1f")                             \
+    X(STR_RESTART, "Press [ENTER] to Restart", "Pressione [ENTER] para Reiniciar", "Druecke [ENTER] zum Neustart")     \
+    X(STR_RETURN_HOME, "Press [H] to return to Home", "Pressione [H] para voltar ao Inicio", "Druecke [H] fuer Home")  \
+    X(STR_LINES_CLEARED, "Lines Cleared: %i", "Linhas Limpas: %i", "Geloeschte Linien: %i")                            \
+    X(STR_NEW_HIGH_SCORE, "New High Score!", "Novo Recorde!", "Neuer Highscore!")                                      \
+    X(STR_ENTER_NAME, "Enter your name:", "Insira o seu nome:", "Gib deinen Namen ein:")                               \
+    X(STR_CONFIRM_NAME, "Press <ENTER> to confirm",                                                                    \
+      "Pressione <ENTER> para confirmar",                                                                              \
+      "Druecke <ENTER> zum Bestaetigen")                                                                               \
+    X(STR_PLAY_AGAIN, "Press <ENTER> again to play",                                                                   \
+      "Pressione <Enter> outra vez para jogar",                                                                        \
+      "Druecke noch einmal <Enter> zum Spielen")                                                                       \
+    X(STR_TOP_SCORES, "Top Scores:", "Melhores Pontuacoes:", "Bestenliste:")
+
+enum StringId
+{
+#define STRING_ID(id, english, portuguese, german) id,
+    LOCALIZED_STRINGS(STRING_ID)
+#undef STRING_ID
+    STRING_COUNT
+};
+
+constexpr char const *BUILTIN_STRINGS[BUILTIN_LANGUAGES][STRING_COUNT] = {
+#define ENGLISH_STRING(id, english, portuguese, german) english,
+#define PORTUGUESE_STRING(id, english, portuguese, german) portuguese,
+#define GERMAN_STRING(id, english, portuguese, german) german,
+    {LOCALIZED_STRINGS(ENGLISH_STRING)},
+    {LOCALIZED_STRINGS(PORTUGUESE_STRING)},
+    {LOCALIZED_STRINGS(GERMAN_STRING)},
+#undef ENGLISH_STRING
+#undef PORTUGUESE_STRING
+#undef GERMAN_STRING
+};
+
+// The ids' names, as written in language pack sources
+extern char const *const STRING_NAMES[STRING_COUNT];
+
+// Maps the pack at path, replacing any previous one. Returns false, keeping the previous pack, if the file cannot be
+// mapped or is malformed. Strings whose printf conversions differ from the English ones are ignored.
+bool loadLanguagePack(char const *path);
+void unloadLanguagePack();
+
+// Pack string for id, English when there is no pack or it lacks the string
+char const *packString(StringId id);
+
+inline char const *localizedString(Language language, StringId id)
+{
+    return language < BUILTIN_LANGUAGES ? BUILTIN_STRINGS[language][id] : packString(id);
+}
+
+// Whether the printf conversions of a and b are the same and in the same order
+bool sameConversions(char const *a, char const *b);
+
+#endif // !LOCALIZATION_H
@@ -1,7 +1,18 @@
 #include "raylib.h"
 
+#include "cosmetic_rng.h"
+#include "draw_list.h"
+#include "frame_pacing.h"
+#include "game.h"
+#include "localization.h"
+#include "particles.h"
+#include "quality.h"
+#include "replay.h"
 #include "score.h"
-#include <cassert>
+#include "sim_thread.h"
+#include "starfield.h"
+#include "text_layout.h"
+#include "texture_atlas.h"
 #include <cmath>
 #include <cstdio>
 #include <ctime>
@@ -10,18 +21,19 @@
 
 Font font;
 
-int const GRID_HORIZONTAL_SIZE = 16;
-int const GRID_VERTICAL_SIZE = 22;
 int const BLOCK_SIZE = 27;
 
-int const TOTAL_PIECES_TYPES = 7;
+static_assert(GRID_VERTICAL_SIZE * BLOCK_SIZE == ARENA_HEIGHT, "The transition arena must match the window height");
 
-int grid[GRID_VERTICAL_SIZE][GRID_HORIZONTAL_SIZE] = {0};
+Game game;    // The snapshot being shown, the main thread only ever reads it
+Game simGame; // Stepped by the simulation thread while a game runs
+ReplayWriter replayWriter;
+char const *REPLAY_FILE = "last_replay.tsr";
 int gridWidth = GRID_HORIZONTAL_SIZE * BLOCK_SIZE;
 int gridHeight = GRID_VERTICAL_SIZE * BLOCK_SIZE;
 bool showGrid = true;
 
-int const screenWidth = 1150;
+int const screenWidth = ARENA_WIDTH;
 int const screenHeight = gridHeight;
 
 // Setting
@@ -43,75 +55,78 @@ bool isHighScore = false;
 float cursorBlinkTimer = 0.0f;
 bool showCursor = true;
 
-int const MAX_STARS = 25;
-Vector2 stars[MAX_STARS];
+Starfield starfield;
 
-int level = 1;
-int linesClearedTotal = 0;
-int linesClearedThisLevel = 0;
-int const BASE_LINES_PER_LEVEL = 1;
-int const LINES_INCREMENT_PER_LEVEL = 1;
-float baseFallSpeed = 0.3f;
+// What the starfield is drawn with this frame, kept until the draw list flushes
+struct StarfieldFrame
+{
+    float time;
+    Vector2 shake;
+    bool twinkle;
+};
+StarfieldFrame starfieldFrame;
 
 float gameTime = 0.0f;
-float lateralTimer = 0.0f;
-float lateralSpeed = 0.07f;
-float fallTimer = 0.0f;
-float fallSpeed = 0.3f;
-float fallVelocity = 0.0f;
-float fallAcceleration = 4.5f;
-float bottomedTimer = 0.0f;
+
+QualityGovernor qualityGovernor;
+double frameStartTime = 0.0;
+float frameWorkTime = 0.0f; // Seconds from the start of the frame to EndDrawing, waits excluded
+
+// Full rate rendering. The simulation ticks at SIM_TICK_RATE whatever the frame rate, frames in between draw the
+// falling piece interpolated, so a 144 or 240 Hz display gets a new position every refresh.
+int const DEFAULT_FPS = 60;    // When the display does not report its refresh rate
+int targetFps = DEFAULT_FPS;   // SetTargetFPS while active, 0 for uncapped
+int fullRateFps = DEFAULT_FPS; // What frames are budgeted against: the target, or the display's rate when uncapped
+
+// Input sampling between frames. raylib polls input inside EndDrawing, after its frame wait, so a press made during
+// the wait would reach the simulation only with the next frame. While a game runs below the tick rate the wait is
+// done here instead, polling every tick and posting each poll to the simulation at once. Presses those polls see
+// are latched for the next frame's KeyPressed checks, since the following poll clears raylib's own.
+bool sampleInputBetweenFrames = false;
+bool keyLatched[KEY_KB_MENU + 1];
+bool mouseLatched;
+
+bool KeyPressed(int key)
+{
+    return IsKeyPressed(key) || keyLatched[key];
+}
+
+bool MouseLeftPressed()
+{
+    return IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || mouseLatched;
+}
+
+FramePacing framePacing;
+bool showPacingOverlay = false;
+DrawListStats lastDrawStats; // Counters of the previous frame, the current one's are only final once flushed
+
+QualitySettings const &CurrentQuality()
+{
+    return qualitySettings(qualityGovernor.level);
+}
+
+// Share of a particle burst the current quality emits, at least one particle
+int ScaledParticleCount(int count)
+{
+    int scaled = (int)(count * CurrentQuality().particleShare);
+    return scaled > 0 ? scaled : 1;
+}
 
 const int GRID_OFFSET_X = (screenWidth - GRID_HORIZONTAL_SIZE * BLOCK_SIZE) / 2;
 const int GRID_OFFSET_Y = (screenHeight - GRID_VERTICAL_SIZE * BLOCK_SIZE) / 2;
 
 bool isMenu = true;
-bool gameOver = false;
-bool pause = false;
-bool isInFreeFall = false;
-bool isPlayerVisible = true;
 
 float pulseTimer = 0.0f;
 bool showPulseEffect = false;
 float const PULSE_DURATION = 2.5f;
+int const RING_SEGMENTS = 36; // As many as DrawCircleLines used
 
-bool isElectrocuted = false;
-float electrocutionTimer = 0.0f;
-const float ELECTROCUTION_DURATION = 2.0f;
-
-struct Unit
-{
-    Vector2 position;
-};
-
-enum PieceState
-{
-    NEW,
-    FALL,
-    FREE_FALL,
-    BOTTOMED,
-    LOCKED
-};
-
-struct Tetromino
-{
-    Unit units[4];
-    int size = 4;
-    PieceState pieceState = NEW;
-};
-
-struct Particle
-{
-    Vector2 position;
-    Vector2 velocity;
-    Color color;
-    float alpha;
-    float size;
-    float life;
-};
-int const MAX_PARTICLES = 100;
-Particle particles[MAX_PARTICLES];
-int particleCount = 0;
+ParticlePool particles;
+int const DOOR_HIT_PARTICLES = 777;
+float const RING_SPARKLE_RATE = 480.0f; // Sparkles per second along each ring, 8 a frame at 60 fps
+float sparkleBacklog = 0.0f;            // Sparkles due but not yet whole, carried to the next frame
+int const LINE_CLEAR_PARTICLES_PER_BLOCK = 4;
 
 Sound doorHitSound;
 Sound levelStartSound;
@@ -128,18 +143,33 @@ enum GameState
 };
 GameState gameState = HOME;
 
-enum Language
-{
-    ENGLISH,
-    PORTUGUESE,
-    GERMAN
-};
 Language currentLanguage = ENGLISH;
 
-// Flag textures
-Texture2D flagPortugal;
-Texture2D flagGermany;
-Texture2D flagUK;
+char const *Localized(StringId id)
+{
+    return localizedString(currentLanguage, id);
+}
+
+// Left edge that centres localized string id at fontSize in the window
+float CenteredX(StringId id, float fontSize)
+{
+    return localizedLayout(currentLanguage, id, fontSize).centeredX;
+}
+
+// Font glyphs, flags, baked sprites and the shapes texel, see BuildTextureAtlas()
+Texture2D textureAtlas;
+bool fontInAtlas = false; // Otherwise a font for UnloadFont, which leaves raylib's default one alone
+
+// An image packed into textureAtlas, or uploaded on its own if the atlas could not be built
+struct AtlasEntry
+{
+    Texture2D texture;
+    Rectangle region;
+};
+AtlasEntry flagPortugal;
+AtlasEntry flagGermany;
+AtlasEntry flagUK;
+Texture2D spriteTexture; // What the baked sprites' regions are in
 
 // Flag buttons (increased size and spacing for better usability)
 Rectangle flagButtonPortugal = {20, (float)screenHeight - 85, 100, 70};
@@ -154,81 +184,83 @@ struct PlayerUnit
     float height;
 };
 
-struct Player
+// The procedural body drawn around game.player in the level transition
+struct PlayerSprite
 {
-    Vector2 position;
-    Vector2 velocity;
     PlayerUnit units[12];
     int size = 12;
     float unitSize = 50.0f;
-    bool isJumping = false;
-};
-Player player;
-
-struct Platform
-{
-    Vector2 position;
-    float width = 100.0f;
-    float height = 20.0f;
 };
-Platform platforms[5];
-const int NUM_PLATFORMS = 5;
+PlayerSprite playerSprite;
 
-struct Door
+// The level transition's procedural shapes, rendered once at load and packed into textureAtlas so that a frame draws
+// each one as a single textured quad
+struct BakedSprite
 {
-    Vector2 position;
-    float width = 55.0f;
-    float height = 120.0f;
+    Rectangle region; // Where the sprite lies in spriteTexture
+    Vector2 origin;   // Point of the region drawn at the sprite's position
 };
-Door door;
-
-float transitionTimer = 0.0f;
-const float TRANSITION_DURATION = 10.0f;
+BakedSprite bakedPlayer;
+BakedSprite bakedSilhouette; // The player in white, tinted by the electrocution flash
+BakedSprite bakedDoor;       // Door with its frame, panels, handle and shadow, the origin at the door's top left
+BakedSprite bakedPlatform;
+
+// Cell holding the player's units, the origin being game.player.position; the body lies left of and above it
+Vector2 const PLAYER_CELL = {64, 96};
+Vector2 const PLAYER_CELL_ORIGIN = {56, 72};
+float const DOOR_FRAME = 4.0f;       // Frame width around the door
+Vector2 const DOOR_SHADOW = {10, 5}; // Offset of the shadow behind the door
+float const ATLAS_PADDING = 2.0f;    // Empty texels between regions, so sampling never bleeds into a neighbour
+int const FONT_SIZE = 96;
 
-bool doorHit = false;
-float doorEffectTimer = 0.0f;
-const float DOOR_EFFECT_DURATION = 1.0f;
 bool screenShake = false;
 float shakeTimer = 0.0f;
 const float SHAKE_DURATION = 1.5f;
 
-Tetromino currentPiece;
-void spawnI(Tetromino &piece);
-void spawnJ(Tetromino &piece);
-void spawnL(Tetromino &piece);
-void spawnO(Tetromino &piece);
-void spawnS(Tetromino &piece);
-void spawnT(Tetromino &piece);
-void spawnZ(Tetromino &piece);
-void spawnPiece();
-void UpdateGame();
 void DrawGame();
 void UnloadGame();
 void UpdateDrawFrame(float gameTime);
-void DrawPiece(Tetromino *piece);
+void DrawPiece(Tetromino const &previous, Tetromino const &piece, float alpha, float fall);
 
 Vector2 fromGrid(Vector2 position);
 Vector2 toGrid(Vector2 position);
 
-Tetromino rotatePiece(Tetromino Piece);
-bool canMoveHorizontally(Tetromino currentPiece, int amount);
-bool canMoveDown(Tetromino piece);
-void moveDown(Tetromino &currentPiece);
-
-int score = 0;
 bool justClearedGrid = false;
 
+// Background, grid lines and locked cells, rendered once and redrawn only when one of them changes
+RenderTexture2D boardTexture;
+bool boardDirty = true;
+
+// Menu screens only change with the language and the mute state, so each is composed into menuTexture once per
+// change. Their pulsing glows are baked at rest into menuGlowTexture and only scaled every frame.
+struct MenuGlow
+{
+    Rectangle bounds; // Where the glow lies at rest, both in menuGlowTexture and on screen
+    Vector2 pulse;    // Relative growth of the bounds at the peak of the pulse
+};
+
+int const MAX_MENU_GLOWS = 2;
+
+RenderTexture2D menuTexture;     // Everything but the glows, over black
+RenderTexture2D menuGlowTexture; // The glows at rest, over black
+MenuGlow menuGlows[MAX_MENU_GLOWS];
+int menuGlowCount = 0;
+bool menuValid = false;
+GameState menuState;
+Language menuLanguage;
+bool menuMuted;
+
 void gridBackground()
 {
     isGrayBackground = !isGrayBackground;
+    boardDirty = true;
 }
 
 void UpdateAudioMute()
 {
     Vector2 mousePoint = GetMousePosition();
     // Check if the mute button is clicked
-    if ((CheckCollisionPointRec(mousePoint, muteButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) ||
-        IsKeyPressed('M'))
+    if ((CheckCollisionPointRec(mousePoint, muteButton) && MouseLeftPressed()) || KeyPressed('M'))
     {
         isMuted = !isMuted; // Toggle mute state
 
@@ -245,9 +277,18 @@ void UpdateAudioMute()
     }
 }
 
+// Draw mute/unmute button
+void DrawMuteButton()
+{
+    drawListText(LAYER_TEXT, font, Localized(STR_SOUND), {muteButton.x + 7, muteButton.y - 15}, 17, 1, WHITE);
+    drawListRectangle(LAYER_SCENE, muteButton, isMuted ? RED : DARKGREEN);
+    drawListText(LAYER_TEXT, font, Localized(isMuted ? STR_SOUND_OFF : STR_SOUND_ON),
+                 {muteButton.x + 5, muteButton.y + 10}, 20, 1, WHITE);
+}
+
 bool CheckHighScore(int score)
 {
-    if (linesClearedTotal <= 0)
+    if (game.linesClearedTotal <= 0)
     {
         return false;
     }
@@ -268,11 +309,9 @@ bool CheckHighScore(int score)
 
 void drawHighScore()
 {
-    gameOver = true; // Load the scores first
+    loadScoresFromFile(); // Load the scores first
 
-    loadScoresFromFile();
-
-    isHighScore = CheckHighScore(linesClearedTotal);
+    isHighScore = CheckHighScore(game.linesClearedTotal);
 
     if (isHighScore)
     {
@@ -295,10 +334,8 @@ void StartScreenShake()
     shakeTimer = SHAKE_DURATION;
 }
 
-void CreateElectrocutionEffect(Vector2 position)
+void CreateElectrocutionEffect()
 {
-    isElectrocuted = true;
-    electrocutionTimer = ELECTROCUTION_DURATION;
     StartScreenShake();
 }
 
@@ -311,223 +348,211 @@ void CreateDoorHitEffect(Vector2 position)
     if (audioEnabled && !isMuted)
         PlaySound(doorHitSound);
 
-    int particlesToSpawn = 777;
-    for (int i = 0; i < particlesToSpawn && particleCount < MAX_PARTICLES; i++)
-    {
-        Particle &p = particles[particleCount];
-        p.position = position;
-
-        float angle = (float)GetRandomValue(0, 360) * DEG2RAD;
-        float speed = (float)GetRandomValue(200, 400);
-
-        p.velocity = {cosf(angle) * speed, sinf(angle) * speed};
-        p.color = (i % 3 == 0) ? GOLD : BLACK; // Alternate between gold and black
-        p.alpha = 1.0f;
-        p.size = (float)GetRandomValue(7, 12);
-        p.life = GetRandomValue(5, 35) / 10.0f; // 0.5 to 3.5 seconds
-        particleCount++;
-    }
-
-    doorHit = true;
-    doorEffectTimer = DOOR_EFFECT_DURATION;
+    ParticleEmitter burst = {position, 0.0f, EMIT_RADIAL, 200.0f, 400.0f, 7.0f, 12.0f, 0.5f, 3.5f, {GOLD, BLACK}, 3};
+    emitParticles(particles, burst, ScaledParticleCount(DOOR_HIT_PARTICLES));
 }
 
-void drawLevelTransition()
+void InitPlayerSprite()
 {
-    gameState = LEVEL_TRANSITION;
-    level++;
-    fallSpeed = baseFallSpeed / (1.0f + (level - 1) * 0.1f);
-    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
-        for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-            grid[y][x] = 0;
-    score = 0;
-    linesClearedThisLevel = 0;
-    gameOver = false;
-    doorHit = false;
-    doorEffectTimer = 0.0f;
-    showPulseEffect = false;
-    pulseTimer = 0.0f;
-    particleCount = 0;
-
-    player.position = {(float)screenWidth - 50, 25.0f};
-    player.velocity = {0, 0};
-    player.isJumping = false;
-
-    player.units[0] = {{0, -27}, {255, 204, 153, 255}, 14.0f, 17.0f}; // Head (skin tone)
-    player.units[1] = {{0, 0}, {0, 128, 255, 255}, 18.0f, 25.0f};     // Torso
-    player.units[2] = {{-13, -3}, {204, 153, 102, 255}, 4.5f, 24.0f}; // Left arm
-    player.units[3] = {{5, -3}, {204, 153, 102, 255}, 4.5f, 24.0f};   // Right arm
-    player.units[4] = {{-5, 25}, {0, 0, 255, 255}, 7.0f, 28.0f};      // Left leg
-    player.units[5] = {{6, 25}, {0, 0, 255, 255}, 7.0f, 28.0f};       // Right leg
-    player.units[6] = {{0, -35}, {0, 0, 0, 255}, 15.0f, 6.0f};        // Hat or hair
-    player.units[7] = {{-4, -29}, {0, 0, 0, 255}, 3.0f, 3.0f};        // Left eye
-    player.units[8] = {{1, -29}, {0, 0, 0, 255}, 3.0f, 3.0f};         // Right eye
-    player.units[9] = {{-2, -24}, {255, 102, 102, 255}, 7.0f, 2.0f};  // Mouth
-    player.units[10] = {{-2, -22}, {255, 102, 102, 255}, 5.0f, 1.0f}; // Mouth (smile)
-    player.units[11] = {{0, -16}, {255, 204, 153, 255}, 6, 8};        // Neck
-
-    // Initialize platforms
-    float startX = screenWidth - platforms[0].width;
-    float spacing = 220.0f;
-    for (int i = 0; i < NUM_PLATFORMS; i++)
-    {
-        float platformX = startX - i * spacing;
-        float minY = screenHeight - 250;
-        float maxY = screenHeight - 50;
-        float platformY = (float)GetRandomValue(minY, maxY);
-        platforms[i].position = {platformX, platformY};
-    }
-
-    door.position = {platforms[NUM_PLATFORMS - 1].position.x - door.width / 2 - 70,
-                     platforms[NUM_PLATFORMS - 1].position.y - door.height / 2 + platforms[0].height / 2};
-
-    transitionTimer = TRANSITION_DURATION;
-    currentPiece.pieceState = NEW;
-    spawnPiece();
+    playerSprite.units[0] = {{0, -27}, {255, 204, 153, 255}, 14.0f, 17.0f}; // Head (skin tone)
+    playerSprite.units[1] = {{0, 0}, {0, 128, 255, 255}, 18.0f, 25.0f};     // Torso
+    playerSprite.units[2] = {{-13, -3}, {204, 153, 102, 255}, 4.5f, 24.0f}; // Left arm
+    playerSprite.units[3] = {{5, -3}, {204, 153, 102, 255}, 4.5f, 24.0f};   // Right arm
+    playerSprite.units[4] = {{-5, 25}, {0, 0, 255, 255}, 7.0f, 28.0f};      // Left leg
+    playerSprite.units[5] = {{6, 25}, {0, 0, 255, 255}, 7.0f, 28.0f};       // Right leg
+    playerSprite.units[6] = {{0, -35}, {0, 0, 0, 255}, 15.0f, 6.0f};        // Hat or hair
+    playerSprite.units[7] = {{-4, -29}, {0, 0, 0, 255}, 3.0f, 3.0f};        // Left eye
+    playerSprite.units[8] = {{1, -29}, {0, 0, 0, 255}, 3.0f, 3.0f};         // Right eye
+    playerSprite.units[9] = {{-2, -24}, {255, 102, 102, 255}, 7.0f, 2.0f};  // Mouth
+    playerSprite.units[10] = {{-2, -22}, {255, 102, 102, 255}, 5.0f, 1.0f}; // Mouth (smile)
+    playerSprite.units[11] = {{0, -16}, {255, 204, 153, 255}, 6, 8};        // Neck
 }
 
-void UpdateLevelTransition(float deltaTime)
+// Draws the player's units around position, all in color when silhouette is set
+void DrawPlayerUnits(Vector2 position, bool silhouette, Color color)
 {
-    if (pause)
-        return;
-
-    if (doorHit)
+    for (int i = 0; i < playerSprite.size; i++)
     {
-        currentPiece.pieceState = NEW;
-        doorEffectTimer -= deltaTime;
-        isPlayerVisible = false;
-        if (doorEffectTimer <= 0.0f)
+        PlayerUnit const &unit = playerSprite.units[i];
+        Vector2 unitPos = {position.x + unit.position.x - playerSprite.unitSize / 2,
+                           position.y + unit.position.y - playerSprite.unitSize / 2};
+        Color drawColor = silhouette ? color : unit.color;
+
+        if (i == 0)
         {
-            isPlayerVisible = true;
-            doorHit = false;
-            gameState = PLAYING;
-            spawnPiece();
+            Rectangle headRect = {unitPos.x - unit.width / 2, unitPos.y - unit.height / 2, unit.width, unit.height};
+            DrawRectangleRounded(headRect, 0.8f, 8, drawColor);
         }
-        return;
-    }
-    if (isElectrocuted)
-    {
-        electrocutionTimer -= deltaTime;
-        if (electrocutionTimer <= 0.0f)
+        else if (i == 2 || i == 3)
         {
-            gameOver = true;
-            isElectrocuted = false;
-            drawHighScore();
-            return;
+            Rectangle armRect = {unitPos.x, unitPos.y, unit.width, unit.height};
+            DrawRectanglePro(armRect, {unit.width / 2, unit.height / 2}, 35.0f, drawColor);
+        }
+        else
+        {
+            Rectangle rect = {unitPos.x - unit.width / 2, unitPos.y - unit.height / 2, unit.width, unit.height};
+            DrawRectangleRec(rect, drawColor);
         }
-        return;
-    }
-
-    const float GRAVITY = 500.0f;
-    player.velocity.y += GRAVITY * deltaTime;
-
-    const float MOVE_SPEED = 200.0f;
-    if (IsKeyDown(KEY_LEFT))
-    {
-        player.velocity.x = -MOVE_SPEED;
-    }
-    else if (IsKeyDown(KEY_RIGHT))
-    {
-        player.velocity.x = MOVE_SPEED;
-    }
-    else
-    {
-        player.velocity.x = 0;
-    }
-
-    if (IsKeyPressed(KEY_SPACE) && !player.isJumping)
-    {
-        player.velocity.y = -450.0f;
-        player.isJumping = true;
-    }
-
-    else if (IsKeyPressed('C'))
-    {
-        gameState = PLAYING;
-        currentPiece.pieceState = NEW;
     }
+}
 
-    player.position.x += player.velocity.x * deltaTime;
-    player.position.y += player.velocity.y * deltaTime;
+void DrawDoor(Rectangle doorRect)
+{
+    Rectangle shadowRect = {doorRect.x + DOOR_SHADOW.x, doorRect.y + DOOR_SHADOW.y, doorRect.width, doorRect.height};
+    DrawRectangleRec(shadowRect, (Color){0, 0, 0, 50});
 
-    float boundingWidth = 24.0f;
-    float boundingHeight = 50.0f;
-    if (player.position.x - boundingWidth / 2 < 0 || player.position.x + boundingWidth / 2 > screenWidth)
-    {
-        Vector2 playerCenter = {player.position.x, player.position.y};
-        CreateElectrocutionEffect(playerCenter);
-        return;
-    }
+    Rectangle frameRect = {doorRect.x - DOOR_FRAME, doorRect.y - DOOR_FRAME, doorRect.width + 2 * DOOR_FRAME,
+                           doorRect.height + 2 * DOOR_FRAME};
+    DrawRectangleRec(frameRect, (Color){139, 69, 19, 255});
 
-    Rectangle playerRect = {player.position.x - boundingWidth / 2, player.position.y - boundingHeight / 2,
-                            boundingWidth, boundingHeight};
+    DrawRectangleRec(doorRect, (Color){165, 42, 42, 255});
 
-    for (int i = 0; i < NUM_PLATFORMS; i++)
-    {
-        Rectangle platformRect = {platforms[i].position.x, platforms[i].position.y, platforms[i].width,
-                                  platforms[i].height};
+    Rectangle topPanel = {doorRect.x + 4, doorRect.y + 4, doorRect.width - 8, (doorRect.height - 12) / 2};
+    Rectangle bottomPanel = {doorRect.x + 4, doorRect.y + doorRect.height / 2 + 2, doorRect.width - 8,
+                             (doorRect.height - 12) / 2};
+    DrawRectangleRec(topPanel, (Color){139, 69, 19, 255});
+    DrawRectangleRec(bottomPanel, (Color){139, 69, 19, 255});
 
-        if (CheckCollisionRecs(playerRect, platformRect))
-        {
-            float dx = (playerRect.x + playerRect.width / 2) - (platformRect.x + platformRect.width / 2);
-            float dy = (playerRect.y + playerRect.height / 2) - (platformRect.y + platformRect.height / 2);
-            float overlapX = abs(dx) - (playerRect.width / 2 + platformRect.width / 2);
-            float overlapY = abs(dy) - (playerRect.height / 2 + platformRect.height / 2);
+    Vector2 handlePos = {doorRect.x + doorRect.width - 6, doorRect.y + doorRect.height * 0.6f};
+    DrawCircleV(handlePos, 2.0f, GOLD);
+    DrawCircleLines(handlePos.x, handlePos.y, 2.0f, BLACK);
+}
 
-            if (overlapX < 0 && overlapY < 0)
-            {
-                if (abs(overlapX) < abs(overlapY))
-                {
-                    if (dx > 0)
-                    {
-                        player.position.x = platformRect.x + platformRect.width + boundingWidth / 2;
-                    }
-                    else
-                    {
-                        player.position.x = platformRect.x - boundingWidth / 2;
-                    }
-                    player.velocity.x = 0;
-                }
-                else
-                {
-                    if (dy > 0)
-                    {
-                        player.position.y = platformRect.y + platformRect.height + boundingHeight / 2;
-                        player.velocity.y = 0; // Stop vertical movement
-                    }
-                    else if (dy < 0 && player.velocity.y > 0)
-                    {
-                        player.position.y = platformRect.y - boundingHeight / 2;
-                        player.velocity.y = 0;
-                        player.isJumping = false;
-                    }
-                }
-            }
-        }
+// Reserves the next region of a one-row atlas layout
+BakedSprite PackSprite(float &cursor, float &height, Vector2 size, Vector2 origin)
+{
+    BakedSprite sprite = {{cursor, 0, size.x, size.y}, origin};
+    cursor += size.x + ATLAS_PADDING;
+    if (size.y > height)
+        height = size.y;
+    return sprite;
+}
 
-        Rectangle doorRect = {door.position.x, door.position.y, door.width, door.height};
-        if (CheckCollisionRecs(playerRect, doorRect))
-        {
-            Vector2 doorCenter = {door.position.x + door.width / 2, door.position.y + door.height / 2};
-            CreateDoorHitEffect(doorCenter);
+// Renders the sprites side by side and reads them back, the sprite regions being relative to the returned image
+Image BakeSprites()
+{
+    Door const &door = game.door;
+    Platform const &platform = game.platforms[0]; // Every platform has the same size
+    float width = 0;
+    float height = 0;
+    bakedPlayer = PackSprite(width, height, PLAYER_CELL, PLAYER_CELL_ORIGIN);
+    bakedSilhouette = PackSprite(width, height, PLAYER_CELL, PLAYER_CELL_ORIGIN);
+    // The frame sticks out left and above, the shadow further than the frame right and below
+    Vector2 doorCell = {DOOR_FRAME + door.width + DOOR_SHADOW.x, DOOR_FRAME + door.height + DOOR_SHADOW.y};
+    bakedDoor = PackSprite(width, height, doorCell, {DOOR_FRAME, DOOR_FRAME});
+    bakedPlatform = PackSprite(width, height, {platform.width, platform.height},
+                               {platform.width / 2, platform.height / 2});
+    RenderTexture2D sprites = LoadRenderTexture((int)width, (int)height);
+
+    // Premultiplied blending keeps the door shadow's own alpha in the cleared texture instead of squaring it.
+    // Every other shape is opaque, and black is the same premultiplied or not, so the sprites draw with plain
+    // alpha blending.
+    BeginTextureMode(sprites);
+    ClearBackground(BLANK);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawPlayerUnits({bakedPlayer.region.x + bakedPlayer.origin.x, bakedPlayer.origin.y}, false, WHITE);
+    DrawPlayerUnits({bakedSilhouette.region.x + bakedSilhouette.origin.x, bakedSilhouette.origin.y}, true, WHITE);
+    DrawDoor({bakedDoor.region.x + bakedDoor.origin.x, bakedDoor.origin.y, door.width, door.height});
+    DrawRectangleRounded(bakedPlatform.region, 1.2f, 8, MAROON);
+    EndBlendMode();
+    EndTextureMode();
+
+    // Render textures are stored bottom up
+    Image image = LoadImageFromTexture(sprites.texture);
+    ImageFlipVertical(&image);
+    UnloadRenderTexture(sprites);
+    return image;
+}
 
-            return;
-        }
+void MoveBakedSprite(BakedSprite &sprite, Rectangle atlasRegion)
+{
+    sprite.region.x += atlasRegion.x;
+    sprite.region.y += atlasRegion.y;
+}
 
-        if (player.position.y - boundingHeight / 2 > screenHeight)
+// Packs everything drawn from a fixed image into textureAtlas. The font, the sprites and raylib's shape drawing are
+// then pointed at their regions.
+void BuildTextureAtlas()
+{
+    enum AtlasImage
+    {
+        ATLAS_FONT,
+        ATLAS_FLAG_PORTUGAL,
+        ATLAS_FLAG_GERMANY,
+        ATLAS_FLAG_UK,
+        ATLAS_SPRITES,
+        ATLAS_SOLID,
+        ATLAS_IMAGES
+    };
+    Image images[ATLAS_IMAGES] = {};
+    Rectangle regions[ATLAS_IMAGES];
+
+    fontInAtlas = loadFontGlyphs("resources/font.ttf", FONT_SIZE, font, images[ATLAS_FONT]);
+    if (!fontInAtlas)
+        font = GetFontDefault();
+
+    // Flags are only ever drawn at the size of their buttons
+    images[ATLAS_FLAG_PORTUGAL] = LoadImage("resources/flag_portugal.jpeg");
+    images[ATLAS_FLAG_GERMANY] = LoadImage("resources/flag_germany.jpeg");
+    images[ATLAS_FLAG_UK] = LoadImage("resources/flag_uk.jpeg");
+    ImageResize(&images[ATLAS_FLAG_PORTUGAL], (int)flagButtonPortugal.width, (int)flagButtonPortugal.height);
+    ImageResize(&images[ATLAS_FLAG_GERMANY], (int)flagButtonGermany.width, (int)flagButtonGermany.height);
+    ImageResize(&images[ATLAS_FLAG_UK], (int)flagButtonUK.width, (int)flagButtonUK.height);
+
+    images[ATLAS_SPRITES] = BakeSprites();
+    // Shapes sample the middle texel, its white neighbours keep filtering from reaching the padding
+    images[ATLAS_SOLID] = GenImageColor(3, 3, WHITE);
+
+    textureAtlas = buildAtlas(images, ATLAS_IMAGES, (int)ATLAS_PADDING, regions);
+    if (textureAtlas.id == 0)
+    {
+        // Everything gets a texture of its own as before the atlas, the font as LoadFontEx would give it, and
+        // shapes keep raylib's own texture
+        TraceLog(LOG_WARNING, "Texture atlas could not be built, loading its images one by one");
+        if (fontInAtlas)
+            font.texture = LoadTextureFromImage(images[ATLAS_FONT]);
+        fontInAtlas = false;
+        AtlasEntry *flags[] = {&flagPortugal, &flagGermany, &flagUK};
+        for (int i = 0; i < 3; i++)
         {
-            gameOver = true;
-            drawHighScore();
-            return;
+            Image const &image = images[ATLAS_FLAG_PORTUGAL + i];
+            *flags[i] = {LoadTextureFromImage(image), {0, 0, (float)image.width, (float)image.height}};
         }
+        spriteTexture = LoadTextureFromImage(images[ATLAS_SPRITES]);
     }
-
-    transitionTimer -= deltaTime;
-    if (transitionTimer <= 0.0f)
+    for (int i = 0; i < ATLAS_IMAGES; i++)
     {
-        gameOver = true;
-        drawHighScore();
+        UnloadImage(images[i]);
     }
+    if (textureAtlas.id == 0)
+        return;
+
+    if (fontInAtlas)
+        placeFont(font, textureAtlas, regions[ATLAS_FONT]);
+    flagPortugal = {textureAtlas, regions[ATLAS_FLAG_PORTUGAL]};
+    flagGermany = {textureAtlas, regions[ATLAS_FLAG_GERMANY]};
+    flagUK = {textureAtlas, regions[ATLAS_FLAG_UK]};
+    spriteTexture = textureAtlas;
+    MoveBakedSprite(bakedPlayer, regions[ATLAS_SPRITES]);
+    MoveBakedSprite(bakedSilhouette, regions[ATLAS_SPRITES]);
+    MoveBakedSprite(bakedDoor, regions[ATLAS_SPRITES]);
+    MoveBakedSprite(bakedPlatform, regions[ATLAS_SPRITES]);
+    SetShapesTexture(textureAtlas, {regions[ATLAS_SOLID].x + 1, regions[ATLAS_SOLID].y + 1, 1, 1});
+}
+
+void DrawBakedSprite(BakedSprite const &sprite, Vector2 position, Color tint)
+{
+    Rectangle dest = {position.x - sprite.origin.x, position.y - sprite.origin.y, sprite.region.width,
+                      sprite.region.height};
+    drawListTexture(LAYER_SCENE, spriteTexture, sprite.region, dest, tint, BLEND_ALPHA);
+}
+
+void drawLevelTransition()
+{
+    gameState = LEVEL_TRANSITION;
+    showPulseEffect = false;
+    pulseTimer = 0.0f;
+    clearParticles(particles);
 }
 
 void DrawPulseEffect(float deltaTime)
@@ -539,6 +564,7 @@ void DrawPulseEffect(float deltaTime)
     if (pulseTimer <= 0)
     {
         showPulseEffect = false;
+        sparkleBacklog = 0.0f;
         return;
     }
 
@@ -546,6 +572,12 @@ void DrawPulseEffect(float deltaTime)
     float maxRadius = sqrtf(powf(screenWidth, 2) + powf(screenHeight, 2)) / 2;
 
     Vector2 center = {(float)screenWidth / 2, (float)screenHeight / 2};
+    int ringCircles = CurrentQuality().ringCircles;
+
+    // Emitted by the second, so a ring gets as many sparkles at 240 fps as at 60
+    sparkleBacklog += deltaTime * RING_SPARKLE_RATE * CurrentQuality().particleShare;
+    int sparkleCount = (int)sparkleBacklog;
+    sparkleBacklog -= sparkleCount;
 
     for (int i = 0; i < 3; i++)
     {
@@ -557,263 +589,500 @@ void DrawPulseEffect(float deltaTime)
         Color ringColor = DARKBLUE;
         ringColor.a = (unsigned char)((1.0f - ringProgress) * 255 * 0.7f);
 
-        // Draw thick ring using multiple circles
-        for (int thickness = -2; thickness <= 2; thickness++)
+        // Draw thick ring using multiple circles, 8 pixels across whatever their number
+        for (int circle = 0; circle < ringCircles; circle++)
         {
-            DrawCircleLines((int)center.x, (int)center.y, ringRadius + (thickness * 2), ringColor);
+            float offset = ringCircles > 1 ? -4.0f + 8.0f * circle / (ringCircles - 1) : 0.0f;
+            drawListRing(LAYER_EFFECTS, center, ringRadius + offset - 0.5f, ringRadius + offset + 0.5f,
+                         RING_SEGMENTS, ringColor);
         }
 
-        // Add some sparkles at the edge
-        if (particleCount < MAX_PARTICLES - 8)
-        {
-            for (int j = 0; j < 8; j++)
-            {
-                float angle = (float)GetRandomValue(0, 360) * DEG2RAD;
-                Particle &p = particles[particleCount];
-                p.position = {center.x + cosf(angle) * ringRadius, center.y + sinf(angle) * ringRadius};
-                p.velocity = {cosf(angle) * GetRandomValue(100, 200) / 100.0f,
-                              sinf(angle) * GetRandomValue(100, 200) / 100.0f};
-                p.color = {255, 215, 0, 255}; // Gold sparkles
-                p.alpha = 1.0f;
-                p.size = (float)GetRandomValue(3, 8);
-                p.life = 0.5f;
-                particleCount++;
-            }
-        }
+        // Add some gold sparkles at the edge
+        ParticleEmitter sparkles = {center, ringRadius, EMIT_RADIAL, 1.0f, 2.0f, 3.0f, 8.0f, 0.5f, 0.5f,
+                                    {{255, 215, 0, 255}, {255, 215, 0, 255}}, 1};
+        emitParticles(particles, sparkles, sparkleCount);
     }
 }
 
+// Particles write their own vertices, the draw list only decides when
+void DrawParticleBatch(void const *)
+{
+    drawParticles(particles, GetTime() * 90);
+}
+
+// Same for the stars, data being the StarfieldFrame
+void DrawStarfieldBatch(void const *data)
+{
+    StarfieldFrame const &frame = *(StarfieldFrame const *)data;
+    drawStarfield(starfield, frame.time, frame.shake, frame.twinkle);
+}
+
 void CreateLineClearEffect(int y)
 {
-    int particlesPerBlock = 4;
     for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
     {
-        for (int p = 0; p < particlesPerBlock && particleCount < MAX_PARTICLES; p++)
-        {
-            Particle &particle = particles[particleCount];
-            particle.position = {(float)(GRID_OFFSET_X + x * BLOCK_SIZE + (float)BLOCK_SIZE / 2),
-                                 (float)(GRID_OFFSET_Y + y * BLOCK_SIZE + (float)BLOCK_SIZE / 2)};
-            particle.velocity = {(float)(GetRandomValue(-200, 200)) / 100.0f,
-                                 (float)(GetRandomValue(-200, 200)) / 100.0f};
-            particle.color = MAROON;
-            particle.alpha = 1.0f;
-            particle.size = (float)GetRandomValue(5, 15);
-            particle.life = 0.5f + GetRandomValue(0, 100) / 100.0f;
-            particleCount++;
-        }
+        Vector2 blockCenter = {(float)(GRID_OFFSET_X + x * BLOCK_SIZE + (float)BLOCK_SIZE / 2),
+                               (float)(GRID_OFFSET_Y + y * BLOCK_SIZE + (float)BLOCK_SIZE / 2)};
+        ParticleEmitter debris = {blockCenter, 0.0f, EMIT_BOX, 0.0f, 2.0f, 5.0f, 15.0f, 0.5f, 1.5f,
+                                  {MAROON, MAROON}, 1};
+        emitParticles(particles, debris, ScaledParticleCount(LINE_CLEAR_PARTICLES_PER_BLOCK));
     }
 }
 
-void UpdateDrawParticles(float deltaTime)
+// Draws the piece between its position before and after the last tick, alpha being how far into the next tick we are.
+// Gravity glides instead: fall is the fallProgress() toward the next row, which reaches 1 just as the piece moves.
+void DrawPiece(Tetromino const &previous, Tetromino const &piece, float alpha, float fall)
 {
-    for (int i = particleCount - 1; i >= 0; i--)
+    // Rotations snap, so both ticks share the shape and only the pivot moves
+    PieceShape const &shape = pieceShape(piece.type, piece.rotation);
+    float pivotX = previous.x + (piece.x - previous.x) * alpha;
+    float pivotY = piece.y + fall;
+    for (int i = 0; i < PIECE_CELLS; i++)
     {
-        Particle &p = particles[i];
+        float x = pivotX + shape.cells[i][0];
+        float y = pivotY + shape.cells[i][1];
+        Vector2 screenPos = {GRID_OFFSET_X + x * BLOCK_SIZE, GRID_OFFSET_Y + y * BLOCK_SIZE};
 
-        p.position.x += p.velocity.x * deltaTime * 60;
-        p.position.y += p.velocity.y * deltaTime * 60;
-        p.life -= deltaTime;
-        p.alpha = p.life / 1.5f;
+        drawListRectangle(LAYER_SCENE, {screenPos.x, screenPos.y, (float)BLOCK_SIZE, (float)BLOCK_SIZE}, pieceColor);
+    }
+}
 
-        // Draw particle
-        Color particleColor = p.color;
-        particleColor.a = (unsigned char)(p.alpha * 255);
-        DrawRectanglePro({p.position.x, p.position.y, p.size, p.size}, {p.size / 2, p.size / 2}, GetTime() * 90,
-                         particleColor);
+void RenderBoardTexture()
+{
+    BeginTextureMode(boardTexture);
+    ClearBackground(BLANK);
+    DrawRectangle(0, 0, gridWidth, gridHeight, isGrayBackground ? gridBrightColor : gridDarkColor);
 
-        // Remove dead particles
-        if (p.life <= 0)
+    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
+    {
+        for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
         {
-            particles[i] = particles[particleCount - 1];
-            particleCount--;
+            if (isCellFilled(game.board, x, y))
+                DrawRectangle(x * BLOCK_SIZE, y * BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, pieceColor);
+            else if (showGrid)
+                DrawRectangleLines(x * BLOCK_SIZE, y * BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, BLACK);
         }
     }
+    DrawRectangleLines(0, 0, gridWidth, gridHeight, BLACK);
+    EndTextureMode();
+
+    boardDirty = false;
 }
 
-void DrawPiece(Tetromino *piece)
+void DrawGrid()
 {
-    for (int i = 0; i < piece->size; i++)
-    {
-        int screenX = GRID_OFFSET_X + (int)piece->units[i].position.x * BLOCK_SIZE;
-        int screenY = GRID_OFFSET_Y + (int)piece->units[i].position.y * BLOCK_SIZE;
+    if (boardDirty)
+        RenderBoardTexture();
 
-        DrawRectangle(screenX, screenY, BLOCK_SIZE, BLOCK_SIZE, pieceColor);
-    }
+    // Render textures are stored bottom-up, hence the negative source height
+    drawListTexture(LAYER_BACKGROUND, boardTexture.texture, {0, 0, (float)gridWidth, -(float)gridHeight},
+                    {(float)GRID_OFFSET_X, (float)GRID_OFFSET_Y, (float)gridWidth, (float)gridHeight}, WHITE,
+                    BLEND_ALPHA);
 }
 
-void DrawGrid()
+// Wall clock plus time since start, so two games started within the same second still differ
+uint64_t NewGameSeed()
 {
-    int gridX = GRID_OFFSET_X;
-    int gridY = GRID_OFFSET_Y;
+    return ((uint64_t)time(0) << 32) ^ (uint64_t)(GetTime() * 1000000.0);
+}
 
-    DrawRectangle(gridX, gridY, gridWidth, gridHeight, isGrayBackground ? gridBrightColor : gridDarkColor);
+// Every session is recorded; the last one is kept on disk so it can be replayed with tetris-replay
+void FinishReplay()
+{
+    stopSimulation();
+    if (!replayWriter.active)
+        return;
 
-    if (showGrid)
+    endReplay(replayWriter, simGame);
+    if (!saveReplay(replayWriter, REPLAY_FILE))
     {
-        for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
-        {
-            for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-            {
-                int screenX = GRID_OFFSET_X + x * BLOCK_SIZE;
-                int screenY = GRID_OFFSET_Y + y * BLOCK_SIZE;
-
-                if (grid[y][x] == 1)
-                {
-                    DrawRectangle(screenX, screenY, BLOCK_SIZE, BLOCK_SIZE, pieceColor);
-                }
-                else
-                {
-                    DrawRectangleLines(screenX, screenY, BLOCK_SIZE, BLOCK_SIZE, BLACK);
-                }
-            }
-        }
+        printf("Could not save %s\n", REPLAY_FILE);
     }
-    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
+}
+
+void StartNewGame()
+{
+    FinishReplay();
+    newGame(simGame, NewGameSeed());
+    beginReplay(replayWriter, simGame);
+    game = simGame; // Shown until the first snapshot arrives
+    startSimulation(simGame);
+    boardDirty = true;
+}
+
+// Samples the keyboard into the simulation's input bits (bit i of GameInput is gameKeys[i])
+GameInput ReadGameInput()
+{
+    static int const gameKeys[] = {KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN, KEY_SPACE, 'P', 'G', 'T', 'C'};
+
+    GameInput input = {0, 0};
+    for (int i = 0; i < (int)(sizeof(gameKeys) / sizeof(gameKeys[0])); i++)
     {
-        for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-        {
-            int screenX = GRID_OFFSET_X + x * BLOCK_SIZE;
-            int screenY = GRID_OFFSET_Y + y * BLOCK_SIZE;
-            if (grid[y][x] == 1)
-            {
-                DrawRectangle(screenX, screenY, BLOCK_SIZE, BLOCK_SIZE, pieceColor);
-            }
-        }
+        if (IsKeyDown(gameKeys[i]))
+            input.down |= 1 << i;
+        if (IsKeyPressed(gameKeys[i]))
+            input.pressed |= 1 << i;
     }
-    DrawRectangleLines(gridX, gridY, gridWidth, gridHeight, BLACK);
+    return input;
 }
 
-int checkAndClearLines()
+// Passes this frame's input to the simulation thread, takes its newest snapshot and turns the snapshot's events
+// into effects, sounds and screens. Ticks run on the simulation's own clock, so the frame rate never changes how
+// the game plays.
+void UpdateSimulation()
 {
-    int linesCleared = 0;
+    bool playing = gameState == PLAYING || gameState == LEVEL_TRANSITION;
+    setSimulationActive(playing);
+    if (!playing)
+        return;
 
-    int y = GRID_VERTICAL_SIZE - 1;
-    while (y >= 0)
+    postSimulationInput(ReadGameInput());
+    if (!takeSnapshot(game))
     {
-        if (y < 0 || y >= GRID_VERTICAL_SIZE)
-        {
-            break;
-        }
-
-        bool isFull = true;
-        for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-        {
-            if (grid[y][x] == 0)
-            {
-                isFull = false;
-                break;
-            }
-        }
+        // Nothing new, the events were handled with the snapshot they came in
+        game.events = 0;
+        return;
+    }
 
-        if (isFull)
-        {
-            linesCleared++;
-            CreateLineClearEffect(y);
+    if (game.events & EVENT_TOGGLE_GRID)
+    {
+        showGrid = !showGrid;
+        boardDirty = true;
+    }
 
-            for (int aboveY = y; aboveY > 0; aboveY--)
-            {
-                for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-                {
-                    grid[aboveY][x] = grid[aboveY - 1][x];
-                }
-            }
+    // Locks, line clears and the level transition's fresh board
+    if (game.events & (EVENT_PIECE_LOCKED | EVENT_LEVEL_UP))
+        boardDirty = true;
 
-            // Clear the top line
-            for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-            {
-                grid[0][x] = 0;
-            }
-        }
-        else
-        {
-            y--;
-        }
-    }
-    score += linesCleared * 10 * level;
-    linesClearedTotal += linesCleared;
-    linesClearedThisLevel += linesCleared;
+    if (game.events & EVENT_TOGGLE_THEME)
+        gridBackground();
 
-    bool isGridEmpty = true;
-    for (int y = 0; y < GRID_VERTICAL_SIZE && isGridEmpty; y++)
+    if (game.events & EVENT_LINES_CLEARED)
     {
-        for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
+        for (int i = 0; i < game.linesCleared; i++)
         {
-            if (grid[y][x] != 0)
-            {
-                isGridEmpty = false;
-                break;
-            }
+            CreateLineClearEffect(game.clearedRows[i]);
         }
     }
 
-    if (isGridEmpty && linesCleared > 0)
+    if (game.events & EVENT_GRID_CLEARED)
     {
-        score += 50;
         justClearedGrid = true;
         showPulseEffect = true;
         pulseTimer = PULSE_DURATION;
     }
-    else
+
+    if (game.events & EVENT_LEVEL_UP)
+        drawLevelTransition();
+
+    if (game.events & EVENT_DOOR_HIT)
     {
-        justClearedGrid = false;
+        Vector2 doorCenter = {game.door.position.x + game.door.width / 2, game.door.position.y + game.door.height / 2};
+        CreateDoorHitEffect(doorCenter);
     }
 
-    int linesNeeded = level * level;
+    if (game.events & EVENT_ELECTROCUTED)
+        CreateElectrocutionEffect();
+
+    if (game.events & EVENT_TRANSITION_DONE)
+        gameState = PLAYING;
 
-    if (linesClearedThisLevel >= linesNeeded)
+    if (game.events & EVENT_GAME_OVER)
     {
-        drawLevelTransition();
+        FinishReplay();
+        drawHighScore(); // Now call this to handle high score or game over
     }
-    return linesCleared;
 }
 
-int main()
+// Idle rendering. Screens where nothing moves stop redrawing until input arrives, and menus, whose only motion
+// is the glow pulse, first drop to a reduced rate. Any input returns to the full rate at once.
+enum RenderMode
 {
-    SetConfigFlags(FLAG_WINDOW_TRANSPARENT);
-
-    ScoreEntry *latestScores = getScores();
+    RENDER_ACTIVE,
+    RENDER_REDUCED, // SetTargetFPS(IDLE_FPS)
+    RENDER_WAITING, // EnableEventWaiting: EndDrawing blocks until the next input event
+    RENDER_MODES
+};
 
-    printf("Top %d Scores:\n", MAX_SCORES);
-    for (int i = 0; i < MAX_SCORES; i++)
-    {
-        printf("%d. %s - %d\n", i + 1, latestScores[i].name, latestScores[i].linesCleared);
-    }
+int const IDLE_FPS = 20;
+float const IDLE_DELAY = 2.0f;        // Seconds without input before a still screen idles
+float const MENU_SLEEP_DELAY = 60.0f; // Seconds without input before a menu stops pulsing and waits
 
-    srand(time(0));
+// Time, CPU and frames spent in each mode, printed on exit to show what idling saves
+struct RenderModeStats
+{
+    double seconds;
+    double cpuSeconds;
+    long frames;
+};
 
-    InitWindow(screenWidth, screenHeight, "Classic Game: TETRIS");
+RenderMode renderMode = RENDER_ACTIVE;
+RenderModeStats renderStats[RENDER_MODES];
 
-    flagPortugal = LoadTexture("resources/flag_portugal.jpeg");
-    flagGermany = LoadTexture("resources/flag_germany.jpeg");
-    flagUK = LoadTexture("resources/flag_uk.jpeg");
+// Draw list counters summed over every frame, printed on exit as per frame averages
+struct DrawTotals
+{
+    long frames;
+    long commands;
+    long batches;
+    long vertices;
+};
+DrawTotals drawTotals;
+double lastInputTime = 0.0;
+clock_t lastFrameClock;
 
-    InitAudioDevice();
-    levelStartSound = LoadSound("resources/level-Start-Sound.mp3");
-    SetSoundVolume(levelStartSound, 57.0f);
-    doorHitSound = LoadSound("resources/next-level.mp3");
-    SetSoundVolume(doorHitSound, 0.1f);
-    if (isMuted)
+bool InputPending()
+{
+    for (int key = KEY_SPACE; key <= KEY_KB_MENU; key++)
     {
-        SetMasterVolume(0.0f); // Start muted if isMuted is true
+        if (IsKeyDown(key) || IsKeyReleased(key))
+            return true;
     }
-    else
+    Vector2 mouseDelta = GetMouseDelta();
+    return mouseDelta.x != 0 || mouseDelta.y != 0 || GetMouseWheelMove() != 0 ||
+           IsMouseButtonDown(MOUSE_BUTTON_LEFT) || IsMouseButtonDown(MOUSE_BUTTON_RIGHT) ||
+           IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+}
+
+RenderMode ChooseRenderMode()
+{
+    double idleTime = GetTime() - lastInputTime;
+    if (idleTime < IDLE_DELAY)
+        return RENDER_ACTIVE;
+
+    switch (gameState)
     {
-        SetMasterVolume(1.0f); // Start at full volume
+    case HOME:
+    case HOW_TO_PLAY:
+    case RULES:
+        return idleTime < MENU_SLEEP_DELAY ? RENDER_REDUCED : RENDER_WAITING;
+    case HIGH_SCORE_ENTRY:
+        return RENDER_REDUCED; // The cursor blinks
+    case GAME_OVER:
+        return RENDER_WAITING;
+    case PLAYING:
+        // Paused, once the effects started before the pause have played out
+        if (game.paused && particles.count == 0 && !showPulseEffect)
+            return RENDER_WAITING;
+        return RENDER_ACTIVE;
+    default:
+        return RENDER_ACTIVE;
+    }
+}
+
+// Books the frame that just ended to the mode it ran in and picks the mode for the next EndDrawing
+void UpdateRenderMode()
+{
+    clock_t now = clock();
+    RenderModeStats &stats = renderStats[renderMode];
+    stats.seconds += GetFrameTime();
+    stats.cpuSeconds += (double)(now - lastFrameClock) / CLOCKS_PER_SEC;
+    stats.frames++;
+    lastFrameClock = now;
+    if (renderMode == RENDER_ACTIVE)
+    {
+        recordFrame(qualityGovernor, GetFrameTime(), frameWorkTime, 1.0f / fullRateFps);
+        recordFrameTime(framePacing, GetFrameTime());
+    }
+
+    if (InputPending())
+        lastInputTime = GetTime();
+
+    RenderMode mode = ChooseRenderMode();
+    bool sampleInput = mode == RENDER_ACTIVE && (gameState == PLAYING || gameState == LEVEL_TRANSITION) &&
+                       targetFps > 0 && targetFps < SIM_TICK_RATE;
+    if (mode == renderMode && sampleInput == sampleInputBetweenFrames)
+        return;
+    if (mode == RENDER_WAITING)
+        EnableEventWaiting();
+    else if (renderMode == RENDER_WAITING)
+        DisableEventWaiting();
+    SetTargetFPS(mode == RENDER_REDUCED ? IDLE_FPS : sampleInput ? 0 : targetFps);
+    renderMode = mode;
+    sampleInputBetweenFrames = sampleInput;
+}
+
+// Takes the last poll's input: the game buttons go to the simulation, every press is latched for the next frame
+void SampleInput()
+{
+    for (int key = KEY_SPACE; key <= KEY_KB_MENU; key++)
+    {
+        if (IsKeyPressed(key))
+            keyLatched[key] = true;
+    }
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        mouseLatched = true;
+    if (InputPending())
+        lastInputTime = GetTime();
+    postSimulationInput(ReadGameInput());
+}
+
+// Waits until deadline, polling input every tick. The frame takes the last poll itself, like EndDrawing's.
+void WaitSamplingInput(double deadline)
+{
+    double left = deadline - GetTime();
+    while (left > 0)
+    {
+        SampleInput();
+        WaitTime(left < SIM_DT ? left : SIM_DT);
+        PollInputEvents();
+        left = deadline - GetTime();
+    }
+}
+
+void ForgetLatchedInput()
+{
+    memset(keyLatched, 0, sizeof(keyLatched));
+    mouseLatched = false;
+}
+
+void PrintRenderStats()
+{
+    char const *const NAMES[RENDER_MODES] = {"active", "reduced", "waiting"};
+    double seconds = 0;
+    long frames = 0;
+    double idleSeconds = 0;
+    double idleCpu = 0;
+    for (int i = 0; i < RENDER_MODES; i++)
+    {
+        seconds += renderStats[i].seconds;
+        frames += renderStats[i].frames;
+        if (i != RENDER_ACTIVE)
+        {
+            idleSeconds += renderStats[i].seconds;
+            idleCpu += renderStats[i].cpuSeconds;
+        }
+    }
+    if (seconds <= 0)
+        return;
+
+    printf("Rendering over %.1f s:\n", seconds);
+    for (int i = 0; i < RENDER_MODES; i++)
+    {
+        RenderModeStats const &stats = renderStats[i];
+        if (stats.seconds <= 0)
+            continue;
+        printf("  %-8s %8.1f s %8ld frames %6.1f fps, CPU %5.1f%% of a core\n", NAMES[i], stats.seconds, stats.frames,
+               stats.frames / stats.seconds, 100.0 * stats.cpuSeconds / stats.seconds);
+    }
+
+    // GPU work is not measurable from here, frames never submitted stand in for it
+    long fullRateFrames = (long)(seconds * fullRateFps);
+    printf("  %ld of %ld frames at %d fps were not drawn\n", fullRateFrames > frames ? fullRateFrames - frames : 0,
+           fullRateFrames, fullRateFps);
+    RenderModeStats const &active = renderStats[RENDER_ACTIVE];
+    if (idleSeconds > 0 && active.seconds > 0 && active.cpuSeconds > 0)
+    {
+        double activeRate = active.cpuSeconds / active.seconds;
+        printf("  Idle time used %.0f%% less CPU than active rendering\n",
+               100.0 * (1.0 - idleCpu / idleSeconds / activeRate));
+    }
+    if (drawTotals.frames > 0)
+    {
+        double frameCount = (double)drawTotals.frames;
+        printf("  Per frame: %.1f draw commands in %.1f batches, %.0f vertices\n", drawTotals.commands / frameCount,
+               drawTotals.batches / frameCount, drawTotals.vertices / frameCount);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // --language-pack FILE starts in the language of a pack built with tetris-langpack.
+    // --quality low|medium|high fixes the effect quality, auto (the default) lowers it while frames run long.
+    // --opaque skips the transparent framebuffer, which the low preset also does.
+    // --fps N|uncapped sets the frame rate, the display's refresh rate by default.
+    // --pacing starts with the frame pacing overlay shown, F3 toggles it.
+    QualityLevel qualityPreset = QUALITY_HIGH;
+    bool automaticQuality = true;
+    bool opaqueWindow = false;
+    int requestedFps = -1; // The display's refresh rate
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--language-pack") == 0 && hasValue)
+        {
+            if (loadLanguagePack(argv[++i]))
+                currentLanguage = LANGUAGE_PACK;
+            else
+                printf("%s: not a language pack\n", argv[i]);
+        }
+        else if (strcmp(argv[i], "--quality") == 0 && hasValue)
+        {
+            if (!parseQuality(argv[++i], qualityPreset, automaticQuality))
+                printf("Unknown quality %s, use low, medium, high or auto\n", argv[i]);
+        }
+        else if (strcmp(argv[i], "--opaque") == 0)
+        {
+            opaqueWindow = true;
+        }
+        else if (strcmp(argv[i], "--fps") == 0 && hasValue)
+        {
+            char const *value = argv[++i];
+            int fps = atoi(value);
+            if (strcmp(value, "uncapped") == 0)
+                requestedFps = 0;
+            else if (fps > 0)
+                requestedFps = fps;
+            else
+                printf("Unknown frame rate %s, use a number of frames per second or uncapped\n", value);
+        }
+        else if (strcmp(argv[i], "--pacing") == 0)
+        {
+            showPacingOverlay = true;
+        }
     }
+    initQualityGovernor(qualityGovernor, qualityPreset, automaticQuality);
 
-    SetTargetFPS(60);
+    // The game over screen clears to transparent to show the desktop, an opaque window shows black instead
+    if (!opaqueWindow && qualitySettings(qualityPreset).transparentWindow)
+        SetConfigFlags(FLAG_WINDOW_TRANSPARENT);
 
-    font = LoadFontEx("resources/font.ttf", 96, 0, 0);
+    ScoreEntry *latestScores = getScores();
 
-    // initialize stars
-    for (int i = 0; i < MAX_STARS; i++)
+    printf("Top %d Scores:\n", MAX_SCORES);
+    for (int i = 0; i < MAX_SCORES; i++)
     {
-        stars[i].x = GetRandomValue(0, screenWidth);
-        stars[i].y = GetRandomValue(0, screenHeight); // Use screenHeight for Tetris
+        printf("%d. %s - %d\n", i + 1, latestScores[i].name, latestScores[i].linesCleared);
     }
 
+    InitWindow(screenWidth, screenHeight, "Classic Game: TETRIS");
+    seedCosmeticRng(NewGameSeed());
+    generateStarfield(starfield, cosmeticRng(COSMETIC_STARS), screenWidth, screenHeight);
+
+    InitAudioDevice();
+    levelStartSound = LoadSound("resources/level-Start-Sound.mp3");
+    SetSoundVolume(levelStartSound, 57.0f);
+    doorHitSound = LoadSound("resources/next-level.mp3");
+    SetSoundVolume(doorHitSound, 0.1f);
+    if (isMuted)
+    {
+        SetMasterVolume(0.0f); // Start muted if isMuted is true
+    }
+    else
+    {
+        SetMasterVolume(1.0f); // Start at full volume
+    }
+
+    int displayFps = GetMonitorRefreshRate(GetCurrentMonitor());
+    if (displayFps <= 0)
+        displayFps = DEFAULT_FPS;
+    targetFps = requestedFps < 0 ? displayFps : requestedFps;
+    fullRateFps = targetFps > 0 ? targetFps : displayFps;
+    SetTargetFPS(targetFps);
+    lastFrameClock = clock();
+
+    InitPlayerSprite();
+    BuildTextureAtlas();
+    setTextLayoutTarget(font, screenWidth);
+    boardTexture = LoadRenderTexture(gridWidth, gridHeight);
+    menuTexture = LoadRenderTexture(screenWidth, screenHeight);
+    menuGlowTexture = LoadRenderTexture(screenWidth, screenHeight);
+
     while (!WindowShouldClose())
     {
+        if (sampleInputBetweenFrames)
+            WaitSamplingInput(frameStartTime + 1.0 / targetFps);
+        frameStartTime = GetTime();
         // //(if you don't want to see the cursor)
         // HideCursor();
         gameTime += GetFrameTime();
@@ -821,137 +1090,68 @@ int main()
         switch (gameState)
         {
         case HOME:
-            if (IsKeyPressed(KEY_ENTER))
+            if (KeyPressed(KEY_ENTER))
             {
                 if (audioEnabled && !isMuted)
                     PlaySound(levelStartSound);
                 gameState = PLAYING;
-                for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
-                    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-                        grid[y][x] = 0;
-                score = 0;
-                level = 1;
-                linesClearedTotal = 0;
-                linesClearedThisLevel = 0;
-                fallSpeed = baseFallSpeed;
-                currentPiece.pieceState = NEW;
-                spawnPiece();
-                gameOver = false;
-
-                for (int i = 0; i < MAX_STARS; i++)
-                {
-                    stars[i].x = GetRandomValue(0, screenWidth);
-                    stars[i].y = GetRandomValue(0, screenHeight);
-                }
+                StartNewGame();
             }
 
-            if (IsKeyPressed(KEY_SPACE))
+            if (KeyPressed(KEY_SPACE))
                 gameState = HOW_TO_PLAY;
 
-            else if (IsKeyPressed('R'))
+            else if (KeyPressed('R'))
                 gameState = RULES;
             break;
 
         case HOW_TO_PLAY:
-            if (IsKeyPressed(KEY_ENTER))
+            if (KeyPressed(KEY_ENTER))
             {
                 if (audioEnabled && !isMuted)
                 {
                     PlaySound(levelStartSound);
                 }
-                for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
-                {
-                    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-                    {
-                        grid[y][x] = 0;
-                    }
-                }
+                StartNewGame();
                 gameState = PLAYING;
-
-                score = 0;
-                level = 1;
-                linesClearedTotal = 0;
-                linesClearedThisLevel = 0;
-                fallSpeed = baseFallSpeed;
-                currentPiece.pieceState = NEW;
-                spawnPiece();
-                gameOver = false;
-
-                for (int i = 0; i < MAX_STARS; i++)
-                {
-                    stars[i].x = GetRandomValue(0, screenWidth);
-                    stars[i].y = GetRandomValue(0, screenHeight);
-                }
             }
-            if (IsKeyPressed('H'))
+            if (KeyPressed('H'))
                 gameState = HOME;
             break;
 
         case RULES:
-            if (IsKeyPressed(KEY_ENTER))
+            if (KeyPressed(KEY_ENTER))
             {
                 if (audioEnabled && !isMuted)
                     PlaySound(levelStartSound);
                 gameState = PLAYING;
-                for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
-                    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-                        grid[y][x] = 0;
-                score = 0;
-                level = 1;
-                linesClearedTotal = 0;
-                linesClearedThisLevel = 0;
-                fallSpeed = baseFallSpeed;
-                currentPiece.pieceState = NEW;
-                spawnPiece();
-                gameOver = false;
-
-                for (int i = 0; i < MAX_STARS; i++)
-                {
-                    stars[i].x = GetRandomValue(0, screenWidth);
-                    stars[i].y = GetRandomValue(0, screenHeight);
-                }
+                StartNewGame();
             }
-            if (IsKeyPressed('H'))
+            if (KeyPressed('H'))
                 gameState = HOME;
             break;
 
         case PLAYING:
-            if (IsKeyPressed('P'))
-                pause = !pause;
-            if (IsKeyPressed('H'))
+            if (KeyPressed('H'))
                 gameState = HOME;
 
         case LEVEL_TRANSITION:
-            if (IsKeyPressed('P'))
-                pause = !pause;
-            if (IsKeyPressed('H'))
+            if (KeyPressed('H'))
                 gameState = HOME;
 
         case GAME_OVER:
-            if (IsKeyPressed(KEY_ENTER))
+            if (KeyPressed(KEY_ENTER))
             {
                 if (audioEnabled && !isMuted)
                     PlaySound(levelStartSound);
 
                 // Not a high score, just reset game
-                for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
-                    for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-                        grid[y][x] = 0;
-
-                score = 0;
-                level = 1;
-                linesClearedTotal = 0;
-                linesClearedThisLevel = 0;
-                fallSpeed = baseFallSpeed;
-                currentPiece.pieceState = NEW;
-                spawnPiece();
-                gameOver = false;
+                StartNewGame();
                 gameState = PLAYING;
             }
-            if (IsKeyPressed('H'))
+            if (KeyPressed('H'))
             {
                 gameState = HOME;
-                gameOver = false;
             }
             break;
 
@@ -968,7 +1168,7 @@ int main()
                 int key = GetCharPressed();
 
                 // Check for backspace
-                if (IsKeyPressed(KEY_BACKSPACE) && playerNameLength > 0)
+                if (KeyPressed(KEY_BACKSPACE) && playerNameLength > 0)
                 {
                     playerNameLength--;
                     playerName[playerNameLength] = '\0';
@@ -987,32 +1187,16 @@ int main()
             }
 
             // Handle Enter key presses
-            if (IsKeyPressed(KEY_ENTER))
+            if (KeyPressed(KEY_ENTER))
             {
                 if (playerNameLength >= NAME_LEN)
                 {
                     // Start new game
                     if (audioEnabled && !isMuted)
                         PlaySound(levelStartSound);
-                    for (int y = 0; y < GRID_VERTICAL_SIZE; y++)
-                        for (int x = 0; x < GRID_HORIZONTAL_SIZE; x++)
-                            grid[y][x] = 0;
-                    score = 0;
-                    level = 1;
-                    linesClearedTotal = 0;
-                    linesClearedThisLevel = 0;
-                    fallSpeed = baseFallSpeed;
-                    currentPiece.pieceState = NEW;
-                    spawnPiece();
-                    gameOver = false;
+                    StartNewGame();
                     gameState = PLAYING;
 
-                    for (int i = 0; i < MAX_STARS; i++)
-                    {
-                        stars[i].x = GetRandomValue(0, screenWidth);
-                        stars[i].y = GetRandomValue(0, screenHeight);
-                    }
-
                     playerName[0] = '\0';
                     playerNameLength = 0;
                     showCursor = true;
@@ -1025,290 +1209,46 @@ int main()
                         strcpy(playerName, "Anonymous");
                         playerNameLength = strlen(playerName);
                     }
-                    insertScore(playerName, linesClearedTotal);
+                    insertScore(playerName, game.linesClearedTotal);
                     saveScoresToFile();
                     playerNameLength = NAME_LEN; // Use as flag to indicate submission
                 }
             }
             // Handle keyboard input for name
-            if (IsKeyPressed('H') && playerNameLength >= NAME_LEN)
+            if (KeyPressed('H') && playerNameLength >= NAME_LEN)
             {
                 gameState = HOME;
-                gameOver = false;
             }
             break;
         }
+        if (KeyPressed(KEY_F3))
+            showPacingOverlay = !showPacingOverlay;
+        UpdateSimulation();
+        UpdateRenderMode();
         UpdateDrawFrame(gameTime);
+        ForgetLatchedInput();
     }
+    PrintRenderStats();
     // saveScoresToFile();
+    FinishReplay();
     UnloadGame();
     CloseWindow();
     return 0;
 }
 
-void spawnPiece(void)
-{
-    int randomNumber = 0;
-    randomNumber = (rand() / (RAND_MAX / 7)) + 1;
-
-    if (randomNumber == 1)
-        spawnI(currentPiece);
-    else if (randomNumber == 2)
-        spawnJ(currentPiece);
-    else if (randomNumber == 3)
-        spawnL(currentPiece);
-    else if (randomNumber == 4)
-        spawnO(currentPiece);
-    else if (randomNumber == 5)
-        spawnS(currentPiece);
-    else if (randomNumber == 6)
-        spawnT(currentPiece);
-    else if (randomNumber == 7)
-        spawnZ(currentPiece);
-
-    fallTimer = 0.0f;
-    isInFreeFall = false;
-    fallSpeed = baseFallSpeed / (1.0f + (level - 1) * 0.1f);
-
-    assert(currentPiece.pieceState == LOCKED || currentPiece.pieceState == NEW);
-    currentPiece.pieceState = FALL;
-}
-
-void spawnI(Tetromino &piece)
-{
-    piece.units[0].position = (Vector2){(float)GRID_HORIZONTAL_SIZE / 2, 0};
-    piece.units[1].position = (Vector2){piece.units[0].position.x - 1, 0};
-    piece.units[2].position = (Vector2){piece.units[0].position.x + 1, 0};
-    piece.units[3].position = (Vector2){piece.units[0].position.x + 2, 0};
-}
-
-void spawnJ(Tetromino &piece)
-{
-    piece.units[0].position = (Vector2){(float)GRID_HORIZONTAL_SIZE / 2, 0};
-    piece.units[1].position = (Vector2){piece.units[0].position.x, 1};
-    piece.units[2].position = (Vector2){piece.units[0].position.x, 2};
-    piece.units[3].position = (Vector2){piece.units[0].position.x - 1, 2};
-}
-
-void spawnL(Tetromino &piece)
-{
-    piece.units[0].position = (Vector2){(float)GRID_HORIZONTAL_SIZE / 2, 0};
-    piece.units[1].position = (Vector2){piece.units[0].position.x, 1};
-    piece.units[2].position = (Vector2){piece.units[0].position.x, 2};
-    piece.units[3].position = (Vector2){piece.units[0].position.x + 1, 2};
-}
-
-void spawnO(Tetromino &piece)
-{
-    piece.units[0].position = (Vector2){(float)GRID_HORIZONTAL_SIZE / 2, 0};
-    piece.units[1].position = (Vector2){piece.units[0].position.x + 1, 0};
-    piece.units[2].position = (Vector2){piece.units[0].position.x, 1};
-    piece.units[3].position = (Vector2){piece.units[0].position.x + 1, 1};
-}
-
-void spawnS(Tetromino &piece)
-{
-    piece.units[0].position = (Vector2){(float)GRID_HORIZONTAL_SIZE / 2, 0};
-    piece.units[1].position = (Vector2){piece.units[0].position.x + 1, 0};
-    piece.units[2].position = (Vector2){piece.units[0].position.x, 1};
-    piece.units[3].position = (Vector2){piece.units[0].position.x - 1, 1};
-}
-
-void spawnT(Tetromino &piece)
-{
-    piece.units[0].position = (Vector2){(float)GRID_HORIZONTAL_SIZE / 2, 0};
-    piece.units[1].position = (Vector2){piece.units[0].position.x - 1, 1};
-    piece.units[2].position = (Vector2){piece.units[0].position.x, 1};
-    piece.units[3].position = (Vector2){piece.units[0].position.x + 1, 1};
-}
-
-void spawnZ(Tetromino &piece)
-{
-    piece.units[0].position = (Vector2){(float)GRID_HORIZONTAL_SIZE / 2, 0};
-    piece.units[1].position = (Vector2){piece.units[0].position.x - 1, 0};
-    piece.units[2].position = (Vector2){piece.units[0].position.x, 1};
-    piece.units[3].position = (Vector2){piece.units[0].position.x + 1, 1};
-}
-
-void UpdateGame()
-{
-    if (gameState != PLAYING)
-        return;
-
-    if (gameOver)
-        return;
-
-    if (IsKeyPressed('P'))
-        pause = !pause;
-
-    if (pause)
-        return;
-
-    if (IsKeyPressed('G'))
-        showGrid = !showGrid;
-
-    if (IsKeyPressed('T'))
-        gridBackground();
-
-    if (IsKeyPressed('C'))
-        return drawLevelTransition();
-
-    if (IsKeyPressed(KEY_LEFT))
-    {
-        lateralTimer += GetFrameTime();
-        if (lateralTimer >= lateralSpeed)
-        {
-            if (canMoveHorizontally(currentPiece, -1))
-            {
-                for (int i = 0; i < currentPiece.size; i++)
-                {
-                    currentPiece.units[i].position.x -= 1;
-                }
-            }
-        }
-    }
-    if (IsKeyPressed(KEY_RIGHT))
-    {
-        lateralTimer += GetFrameTime();
-        if (lateralTimer >= lateralSpeed)
-        {
-            if (canMoveHorizontally(currentPiece, 1))
-            {
-                for (int i = 0; i < currentPiece.size; i++)
-                {
-                    currentPiece.units[i].position.x += 1;
-                }
-            }
-        }
-    }
-
-    if (IsKeyDown(KEY_LEFT))
-    {
-        lateralTimer += GetFrameTime();
-        if (lateralTimer >= lateralSpeed)
-        {
-            lateralTimer -= lateralSpeed;
-            if (canMoveHorizontally(currentPiece, -1))
-            {
-                for (int i = 0; i < currentPiece.size; i++)
-                {
-                    currentPiece.units[i].position.x -= 1;
-                }
-            }
-        }
-    }
-    else if (IsKeyDown(KEY_RIGHT))
-    {
-        lateralTimer += GetFrameTime();
-        if (lateralTimer >= lateralSpeed)
-        {
-            lateralTimer -= lateralSpeed;
-            if (canMoveHorizontally(currentPiece, 1))
-            {
-                for (int i = 0; i < currentPiece.size; i++)
-                {
-                    currentPiece.units[i].position.x += 1;
-                }
-            }
-        }
-    }
-
-    else
-    {
-        lateralTimer = 0.0f;
-    }
-
-    if (IsKeyPressed(KEY_UP))
-    {
-        currentPiece = rotatePiece(currentPiece);
-    }
-
-    if (IsKeyPressed(KEY_DOWN))
-    {
-        fallSpeed = 0.05f;
-    }
-
-    if (IsKeyPressed(KEY_SPACE))
-    {
-        isInFreeFall = true;
-        fallSpeed = 0.01f;
-    }
-
-    float levelAdjustedFallSpeed = baseFallSpeed / (1.0f + (level - 1) * 0.1f);
-
-    fallTimer += GetFrameTime();
-    if ((currentPiece.pieceState != BOTTOMED && fallTimer >= fallSpeed) || currentPiece.pieceState == BOTTOMED)
-    {
-        fallTimer = 0.0f;
-
-        if (canMoveDown(currentPiece))
-            moveDown(currentPiece);
-        else
-        {
-            if (currentPiece.pieceState == BOTTOMED)
-            {
-                bottomedTimer += GetFrameTime();
-            }
-            else
-            {
-                currentPiece.pieceState = BOTTOMED;
-            }
-
-            // check timer
-            if (bottomedTimer < 0.15f)
-            {
-                return;
-            }
-            else
-            {
-                bottomedTimer = 0.0f;
-                currentPiece.pieceState = LOCKED;
-            }
-
-            for (int i = 0; i < currentPiece.size; i++)
-            {
-                int x = (int)currentPiece.units[i].position.x;
-                int y = (int)currentPiece.units[i].position.y;
-                grid[y][x] = 1;
-            }
-
-            checkAndClearLines();
-            // TODO don't go here if level up
-            if (gameState == PLAYING)
-            {
-                spawnPiece();
-                fallSpeed = levelAdjustedFallSpeed;
-
-                // Check if the new piece overlaps with existing blocks (game over condition)
-                for (int i = 0; i < currentPiece.size; i++)
-                {
-                    int x = (int)currentPiece.units[i].position.x;
-                    int y = (int)currentPiece.units[i].position.y;
-                    if (grid[y][x] == 1) // New piece can't spawn
-                    {
-                        gameOver = true;
-                        drawHighScore(); // Now call this to handle high score or game over
-                        return;
-                    }
-                }
-            }
-        }
-    }
-}
-
 void UpdateLanguageSelection()
 {
     Vector2 mousePoint = GetMousePosition();
 
-    if (CheckCollisionPointRec(mousePoint, flagButtonPortugal) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+    if (CheckCollisionPointRec(mousePoint, flagButtonPortugal) && MouseLeftPressed())
     {
         currentLanguage = PORTUGUESE;
     }
-    else if (CheckCollisionPointRec(mousePoint, flagButtonGermany) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+    else if (CheckCollisionPointRec(mousePoint, flagButtonGermany) && MouseLeftPressed())
     {
         currentLanguage = GERMAN;
     }
-    else if (CheckCollisionPointRec(mousePoint, flagButtonUK) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+    else if (CheckCollisionPointRec(mousePoint, flagButtonUK) && MouseLeftPressed())
     {
         currentLanguage = ENGLISH;
     }
@@ -1317,19 +1257,19 @@ void UpdateLanguageSelection()
 void DrawGame()
 {
     DrawGrid();
-    DrawText(TextFormat("Score: %i", score), 20, 60, 30, BLACK);
-    DrawText(TextFormat("Level: %i", level), 20, 20, 30, BLACK);
-    DrawText(TextFormat("Lines: %i", linesClearedThisLevel), 20, 100, 30, BLACK);
+    DrawText(TextFormat("Score: %i", game.score), 20, 60, 30, BLACK);
+    DrawText(TextFormat("Level: %i", game.level), 20, 20, 30, BLACK);
+    DrawText(TextFormat("Lines: %i", game.linesClearedThisLevel), 20, 100, 30, BLACK);
 
-    int linesNeeded = level * level;
-    DrawText(TextFormat("Next Level: %i/%i lines", linesClearedThisLevel, linesNeeded), 20, 140, 20, DARKGRAY);
+    int linesNeeded = game.level * game.level;
+    DrawText(TextFormat("Next Level: %i/%i lines", game.linesClearedThisLevel, linesNeeded), 20, 140, 20, DARKGRAY);
 
-    if (linesClearedThisLevel < linesNeeded)
+    if (game.linesClearedThisLevel < linesNeeded)
     {
         DrawText("Clear lines to advance!", 20, 180, 20, GRAY);
     }
 
-    float progress = (float)linesClearedThisLevel / linesNeeded;
+    float progress = (float)game.linesClearedThisLevel / linesNeeded;
     if (progress > 1.0f)
         progress = 1.0f;
     DrawRectangle(20, 200, 200, 20, GRAY);
@@ -1348,477 +1288,383 @@ void DrawGame()
     }
 }
 
-void UpdateDrawFrame(float gameTime)
+// Draws the three title glow layers at rest, the largest one outermost. Each layer is 40 + i * layerStep * scale
+// points, the scale pulsing by 0.1 around restScale.
+MenuGlow BakeTitleGlow(StringId id, float y, float layerStep, float restScale, float alphaStep)
 {
-    BeginDrawing();
-    UpdateLanguageSelection(); // Check for language button clicks
-
-    switch (gameState)
+    MenuGlow glow;
+    for (int i = 3; i >= 1; i--)
     {
-    case HOME: {
-        ClearBackground(BLACK);
-        Vector2 textPos;
-        float glowScale = 1.0f + 0.1f * sinf(gameTime * 2.0f);
-        int glowLayers = 3;
-
-        const char *languageText;
-        const char *welcomeText;
-        const char *startText;
-        const char *manualText;
-        const char *rulesText;
-        const char *hText;
-        const char *soundText;
-        const char *onOffText;
-
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            languageText = "Selecao da lingua:";
-            welcomeText = "Bem-vindo ao TETRIS ESPECIAL";
-            startText = "Pressione <ENTER> para Iniciar";
-            manualText = "Pressione <ESPACO> para ver Manual";
-            rulesText = "Pressione <R> para ver as Regras";
-            hText = "(Pode sempre pressionar <H> para voltar a este menu)";
-            soundText = "Som:";
-            onOffText = isMuted ? "DESLIGADO" : "LIGADO";
-            break;
-        case GERMAN:
-            languageText = "Waehle die Sprache:";
-            welcomeText = "Willkommen bei TETRIS SPECIAL";
-            startText = "Druecke <ENTER> zum Starten";
-            manualText = "Druecke <LEERTASTE> um das Handbuch zu sehen";
-            rulesText = "Duecke <R> um das Regelbuch zu sehen";
-            hText = "(Man kann jederzeit auf <H> druecken, um zurueck zu diesem Menu zu kommen)";
-            soundText = "Ton:";
-            onOffText = isMuted ? "AUS" : "AN";
-            break;
-        case ENGLISH:
-        default:
-            languageText = "Choose the language:";
-            welcomeText = "Welcome to TETRIS SPECIAL";
-            startText = "Press <ENTER> to Start";
-            manualText = "Press <SPACE> to go to the Manual";
-            rulesText = "Press <R> to go to the Rules";
-            hText = "(You can always press <H> to go back to this Menu)";
-            soundText = "Sound:";
-            onOffText = isMuted ? "OFF" : "ON";
-            break;
-        }
-
-        DrawTextEx(font, "By:", {(float)screenWidth / 2 - 570, (float)screenHeight / 2 - 280}, 25, 1, WHITE);
-        DrawTextEx(font, "Thomas Gilb de Moura Guedes (feat. Paulo Moura Guedes)",
-                   {(float)screenWidth / 2 - 570, (float)screenHeight / 2 - 250}, 25, 1, WHITE);
-
-        textPos = {(float)screenWidth / 2 - MeasureTextEx(font, welcomeText, 40, 1).x / 2,
-                   (float)screenHeight / 2 - 70};
+        float glowSize = 40 + i * layerStep * restScale;
+        float glowAlpha = 0.3f - (i * alphaStep);
+        Color glowColor = {255, 255, 0, (unsigned char)(glowAlpha * 255)};
+        TextLayout const &layout = localizedLayout(currentLanguage, id, glowSize);
+        Vector2 glowPos = {layout.centeredX, y - i * 2};
+        DrawTextEx(font, Localized(id), glowPos, glowSize, 1, glowColor);
+        if (i == 3)
+            glow.bounds = {glowPos.x - 2, glowPos.y - 2, layout.size.x + 4, layout.size.y + 4};
+    }
+    float pulse = 3 * layerStep * 0.1f / (40 + 3 * layerStep * restScale);
+    glow.pulse = {pulse, pulse};
+    return glow;
+}
 
-        for (int i = glowLayers; i >= 1; i--)
-        {
-            float glowSize = 40 + i * 5 * glowScale;
-            float glowAlpha = 0.3f - (i * 0.1f);
-            Color glowColor = {255, 255, 0, (unsigned char)(glowAlpha * 255)};
-            Vector2 glowPos = {(float)screenWidth / 2 - MeasureTextEx(font, welcomeText, glowSize, 1).x / 2,
-                               (float)screenHeight / 2 - 70 - i * 2};
-            DrawTextEx(font, welcomeText, glowPos, glowSize, 1, glowColor);
-        }
+// Draws the green rings around the selected flag at rest
+MenuGlow BakeFlagGlow(Rectangle flag)
+{
+    for (int i = 3; i >= 1; i--)
+    {
+        float glowSize = i * 5;
+        Color glowColor = {0, 255, 0, (unsigned char)(0.3f * 255 / i)};
+        DrawRectangleLinesEx({flag.x - glowSize, flag.y - glowSize, flag.width + 2 * glowSize,
+                              flag.height + 2 * glowSize},
+                             2, glowColor);
+    }
+    MenuGlow glow = {{flag.x - 15, flag.y - 15, flag.width + 30, flag.height + 30},
+                     {3 / (flag.width + 30), 3 / (flag.height + 30)}};
+    return glow;
+}
 
-        DrawTextEx(font, welcomeText, textPos, 40, 1, WHITE);
-        DrawTextEx(font, languageText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, languageText, 25, 1).x / 2 - 430,
-                             (float)screenHeight / 2 + 170},
-                   25, 1, WHITE);
-        DrawTextEx(font, startText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, startText, 30, 1).x / 2,
-                             (float)screenHeight / 2 - 20},
-                   30, 1, WHITE);
-        DrawTextEx(font, manualText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, manualText, 30, 1).x / 2,
-                             (float)screenHeight / 2 + 20},
-                   30, 1, WHITE);
-        DrawTextEx(font, rulesText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, rulesText, 30, 1).x / 2,
-                             (float)screenHeight / 2 + 60},
-                   30, 1, WHITE);
-        DrawTextEx(
-            font, hText,
-            (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, hText, 30, 1).x / 2, (float)screenHeight / 2 + 100},
-            30, 1, WHITE);
-
-        // Draw mute/unmute button
-
-        DrawTextEx(font, soundText, (Vector2){muteButton.x + 7, muteButton.y - 15}, 17, 1, WHITE);
-        DrawRectangleRec(muteButton, isMuted ? RED : DARKGREEN);
-        DrawTextEx(font, onOffText, (Vector2){muteButton.x + 5, muteButton.y + 10}, 20, 1, WHITE);
-
-        // Draw flag buttons
-        Rectangle sourceRectPortugal = {0, 0, (float)flagPortugal.width, (float)flagPortugal.height};
-        Rectangle destRectPortugal = {flagButtonPortugal.x, flagButtonPortugal.y, flagButtonPortugal.width,
-                                      flagButtonPortugal.height};
-        if (currentLanguage == PORTUGUESE)
-        {
-            // Add green glow effect
-            float glowScale = 1.0f + 0.1f * sinf(gameTime * 2.0f);
-            for (int i = 3; i >= 1; i--)
-            {
-                float glowSize = i * 5 * glowScale;
-                Color glowColor = {0, 255, 0, (unsigned char)(0.3f * 255 / i)};
-                DrawRectangleLinesEx({destRectPortugal.x - glowSize, destRectPortugal.y - glowSize,
-                                      destRectPortugal.width + 2 * glowSize, destRectPortugal.height + 2 * glowSize},
-                                     2, glowColor);
-            }
-        }
-        DrawTexturePro(flagPortugal, sourceRectPortugal, destRectPortugal, {0, 0}, 0.0f, WHITE);
+void ComposeHomeScreen()
+{
+    const char *languageText = Localized(STR_LANGUAGE_CHOICE);
+    const char *welcomeText = Localized(STR_WELCOME);
+    const char *startText = Localized(STR_START_PROMPT);
+    const char *manualText = Localized(STR_MANUAL_PROMPT);
+    const char *rulesText = Localized(STR_RULES_PROMPT);
+    const char *hText = Localized(STR_HOME_HINT);
+
+    Rectangle destRectPortugal = {flagButtonPortugal.x, flagButtonPortugal.y, flagButtonPortugal.width,
+                                  flagButtonPortugal.height};
+    Rectangle destRectGermany = {flagButtonGermany.x, flagButtonGermany.y, flagButtonGermany.width,
+                                 flagButtonGermany.height};
+    Rectangle destRectUK = {flagButtonUK.x, flagButtonUK.y, flagButtonUK.width, flagButtonUK.height};
+
+    BeginTextureMode(menuGlowTexture);
+    ClearBackground(BLACK);
+    menuGlows[0] = BakeTitleGlow(STR_WELCOME, (float)screenHeight / 2 - 70, 5, 1.0f, 0.1f);
+    if (currentLanguage == PORTUGUESE)
+        menuGlows[1] = BakeFlagGlow(destRectPortugal);
+    else if (currentLanguage == GERMAN)
+        menuGlows[1] = BakeFlagGlow(destRectGermany);
+    else
+        menuGlows[1] = BakeFlagGlow(destRectUK);
+    menuGlowCount = 2;
+    EndTextureMode();
+
+    BeginTextureMode(menuTexture);
+    ClearBackground(BLACK);
+    DrawTextEx(font, "By:", {(float)screenWidth / 2 - 570, (float)screenHeight / 2 - 280}, 25, 1, WHITE);
+    DrawTextEx(font, "Thomas Gilb de Moura Guedes (feat. Paulo Moura Guedes)",
+               {(float)screenWidth / 2 - 570, (float)screenHeight / 2 - 250}, 25, 1, WHITE);
+
+    Vector2 textPos = {CenteredX(STR_WELCOME, 40),
+                       (float)screenHeight / 2 - 70};
+    DrawTextEx(font, welcomeText, textPos, 40, 1, WHITE);
+    DrawTextEx(font, languageText,
+               (Vector2){CenteredX(STR_LANGUAGE_CHOICE, 25) - 430,
+                         (float)screenHeight / 2 + 170},
+               25, 1, WHITE);
+    DrawTextEx(font, startText,
+               (Vector2){CenteredX(STR_START_PROMPT, 30),
+                         (float)screenHeight / 2 - 20},
+               30, 1, WHITE);
+    DrawTextEx(font, manualText,
+               (Vector2){CenteredX(STR_MANUAL_PROMPT, 30),
+                         (float)screenHeight / 2 + 20},
+               30, 1, WHITE);
+    DrawTextEx(font, rulesText,
+               (Vector2){CenteredX(STR_RULES_PROMPT, 30),
+                         (float)screenHeight / 2 + 60},
+               30, 1, WHITE);
+    DrawTextEx(font, hText,
+               (Vector2){CenteredX(STR_HOME_HINT, 30),
+                         (float)screenHeight / 2 + 100},
+               30, 1, WHITE);
+
+    DrawMuteButton();
+    drawListFlush(); // The mute button is recorded like on the other screens
+
+    // Draw flag buttons
+    DrawTexturePro(flagPortugal.texture, flagPortugal.region, destRectPortugal, {0, 0}, 0.0f, WHITE);
+    DrawTexturePro(flagGermany.texture, flagGermany.region, destRectGermany, {0, 0}, 0.0f, WHITE);
+    DrawTexturePro(flagUK.texture, flagUK.region, destRectUK, {0, 0}, 0.0f, WHITE);
+
+    DrawRectangleLinesEx(destRectUK, 2, WHITE);
+    DrawRectangleLinesEx(destRectGermany, 2, WHITE);
+    DrawRectangleLinesEx(destRectPortugal, 2, WHITE);
+    EndTextureMode();
+}
 
-        Rectangle sourceRectGermany = {0, 0, (float)flagGermany.width, (float)flagGermany.height};
-        Rectangle destRectGermany = {flagButtonGermany.x, flagButtonGermany.y, flagButtonGermany.width,
-                                     flagButtonGermany.height};
-        if (currentLanguage == GERMAN)
-        {
-            // Add green glow effect
-            float glowScale = 1.0f + 0.1f * sinf(gameTime * 2.0f);
-            for (int i = 3; i >= 1; i--)
-            {
-                float glowSize = i * 5 * glowScale;
-                Color glowColor = {0, 255, 0, (unsigned char)(0.3f * 255 / i)};
-                DrawRectangleLinesEx({destRectGermany.x - glowSize, destRectGermany.y - glowSize,
-                                      destRectGermany.width + 2 * glowSize, destRectGermany.height + 2 * glowSize},
-                                     2, glowColor);
-            }
-        }
-        DrawTexturePro(flagGermany, sourceRectGermany, destRectGermany, {0, 0}, 0.0f, WHITE);
+void ComposeHowToPlayScreen()
+{
+    const char *manualText = Localized(STR_MANUAL_TITLE);
+    const char *playText = Localized(STR_MANUAL_PLAY);
+    const char *tetrisText = Localized(STR_TETRIS_HEADING);
+    const char *moveText = Localized(STR_MOVE);
+    const char *rotateText = Localized(STR_ROTATE);
+    const char *fallText = Localized(STR_FALL);
+    const char *gridText = Localized(STR_GRID_TOGGLE);
+    const char *playerGameText = Localized(STR_MANUAL_PLAYER_GAME);
+    const char *movePlayerText = Localized(STR_MOVE);
+    const char *jumpText = Localized(STR_JUMP);
+    const char *doorText = Localized(STR_MANUAL_DOOR);
+    const char *timeText = Localized(STR_TIME_LIMIT);
+
+    BeginTextureMode(menuGlowTexture);
+    ClearBackground(BLACK);
+    menuGlows[0] = BakeTitleGlow(STR_MANUAL_TITLE, (float)screenHeight / 2 - 240, 10, 1.0f, 0.08f);
+    menuGlowCount = 1;
+    EndTextureMode();
+
+    BeginTextureMode(menuTexture);
+    ClearBackground(BLACK);
+    Vector2 textPos = {CenteredX(STR_MANUAL_TITLE, 40),
+                       (float)screenHeight / 2 - 240};
+    DrawTextEx(font, manualText, textPos, 40, 1, WHITE);
+
+    DrawTextEx(font, playText,
+               (Vector2){CenteredX(STR_MANUAL_PLAY, 35),
+                         (float)screenHeight / 2 - 125},
+               35, 1, WHITE);
+    DrawTextEx(font, tetrisText,
+               (Vector2){CenteredX(STR_TETRIS_HEADING, 35),
+                         (float)screenHeight / 2 - 65},
+               35, 1, WHITE);
+    DrawTextEx(font, moveText,
+               (Vector2){CenteredX(STR_MOVE, 25),
+                         (float)screenHeight / 2 - 25},
+               25, 1, WHITE);
+    DrawTextEx(font, rotateText,
+               (Vector2){CenteredX(STR_ROTATE, 25),
+                         (float)screenHeight / 2},
+               25, 1, WHITE);
+    DrawTextEx(font, fallText,
+               (Vector2){CenteredX(STR_FALL, 25),
+                         (float)screenHeight / 2 + 25},
+               25, 1, WHITE);
+    DrawTextEx(font, gridText,
+               (Vector2){CenteredX(STR_GRID_TOGGLE, 25),
+                         (float)screenHeight / 2 + 50},
+               25, 1, WHITE);
+    DrawTextEx(font, playerGameText,
+               (Vector2){CenteredX(STR_MANUAL_PLAYER_GAME, 35),
+                         (float)screenHeight / 2 + 100},
+               35, 1, WHITE);
+    DrawTextEx(font, movePlayerText,
+               (Vector2){CenteredX(STR_MOVE, 25),
+                         (float)screenHeight / 2 + 140},
+               25, 1, WHITE);
+    DrawTextEx(font, jumpText,
+               (Vector2){CenteredX(STR_JUMP, 25),
+                         (float)screenHeight / 2 + 165},
+               25, 1, WHITE);
+    DrawTextEx(font, doorText,
+               (Vector2){CenteredX(STR_MANUAL_DOOR, 25),
+                         (float)screenHeight / 2 + 190},
+               25, 1, WHITE);
+    DrawTextEx(font, timeText,
+               (Vector2){CenteredX(STR_TIME_LIMIT, 25),
+                         (float)screenHeight / 2 + 215},
+               25, 1, WHITE);
+    EndTextureMode();
+}
 
-        Rectangle sourceRectUK = {0, 0, (float)flagUK.width, (float)flagUK.height};
-        Rectangle destRectUK = {flagButtonUK.x, flagButtonUK.y, flagButtonUK.width, flagButtonUK.height};
-        if (currentLanguage == ENGLISH)
-        {
-            // Add green glow effect
-            float glowScale = 1.0f + 0.1f * sinf(gameTime * 2.0f);
-            for (int i = 3; i >= 1; i--)
-            {
-                float glowSize = i * 5 * glowScale;
-                Color glowColor = {0, 255, 0, (unsigned char)(0.3f * 255 / i)};
-                DrawRectangleLinesEx({destRectUK.x - glowSize, destRectUK.y - glowSize, destRectUK.width + 2 * glowSize,
-                                      destRectUK.height + 2 * glowSize},
-                                     2, glowColor);
-            }
-        }
-        DrawTexturePro(flagUK, sourceRectUK, destRectUK, {0, 0}, 0.0f, WHITE);
+void ComposeRulesScreen()
+{
+    const char *rulesText = Localized(STR_RULES_TITLE);
+    const char *playText = Localized(STR_RULES_PLAY);
+    const char *tetrisText = Localized(STR_TETRIS_HEADING);
+    const char *fullLinesText = Localized(STR_FULL_LINES);
+    const char *gridFullText = Localized(STR_GRID_FULL);
+    const char *playerGameText = Localized(STR_RULES_PLAYER_GAME);
+    const char *dieText = Localized(STR_FALL_DEATH);
+    const char *hitWallText = Localized(STR_WALL_DEATH);
+    const char *doorText = Localized(STR_RULES_DOOR);
+
+    BeginTextureMode(menuGlowTexture);
+    ClearBackground(BLACK);
+    menuGlows[0] = BakeTitleGlow(STR_RULES_TITLE, (float)screenHeight / 2 - 240, 5, 2.0f, 0.1f);
+    menuGlowCount = 1;
+    EndTextureMode();
+
+    BeginTextureMode(menuTexture);
+    ClearBackground(BLACK);
+    Vector2 textPos = {CenteredX(STR_RULES_TITLE, 40),
+                       (float)screenHeight / 2 - 235};
+    DrawTextEx(font, rulesText, textPos, 40, 1, WHITE);
+
+    DrawTextEx(font, playText,
+               (Vector2){CenteredX(STR_RULES_PLAY, 35),
+                         (float)screenHeight / 2 - 105},
+               35, 1, WHITE);
+    DrawTextEx(font, tetrisText,
+               (Vector2){CenteredX(STR_TETRIS_HEADING, 35),
+                         (float)screenHeight / 2 - 40},
+               35, 1, WHITE);
+    DrawTextEx(font, playText,
+               (Vector2){CenteredX(STR_RULES_PLAY, 25),
+                         (float)screenHeight / 2},
+               25, 1, WHITE);
+    DrawTextEx(font, fullLinesText,
+               (Vector2){CenteredX(STR_FULL_LINES, 25),
+                         (float)screenHeight / 2 + 25},
+               25, 1, WHITE);
+    DrawTextEx(font, gridFullText,
+               (Vector2){CenteredX(STR_GRID_FULL, 25),
+                         (float)screenHeight / 2 + 50},
+               25, 1, WHITE);
+    DrawTextEx(font, playerGameText,
+               (Vector2){CenteredX(STR_RULES_PLAYER_GAME, 35),
+                         (float)screenHeight / 2 + 100},
+               35, 1, WHITE);
+    DrawTextEx(font, dieText,
+               (Vector2){CenteredX(STR_FALL_DEATH, 25),
+                         (float)screenHeight / 2 + 140},
+               25, 1, WHITE);
+    DrawTextEx(font, hitWallText,
+               (Vector2){CenteredX(STR_WALL_DEATH, 25),
+                         (float)screenHeight / 2 + 165},
+               25, 1, WHITE);
+    DrawTextEx(font, playText,
+               (Vector2){CenteredX(STR_RULES_PLAY, 35),
+                         (float)screenHeight / 2 - 105},
+               35, 1, WHITE);
+    DrawTextEx(font, doorText,
+               (Vector2){CenteredX(STR_RULES_DOOR, 35) + 110,
+                         (float)screenHeight / 2 + 190},
+               25, 1, WHITE);
+    EndTextureMode();
+}
 
-        DrawRectangleLinesEx(destRectUK, 2, WHITE);
-        DrawRectangleLinesEx(destRectGermany, 2, WHITE);
-        DrawRectangleLinesEx(destRectPortugal, 2, WHITE);
-        break;
+void DrawMenuScreen(float gameTime)
+{
+    if (!menuValid || menuState != gameState || menuLanguage != currentLanguage || menuMuted != isMuted)
+    {
+        if (gameState == HOME)
+            ComposeHomeScreen();
+        else if (gameState == HOW_TO_PLAY)
+            ComposeHowToPlayScreen();
+        else
+            ComposeRulesScreen();
+        menuValid = true;
+        menuState = gameState;
+        menuLanguage = currentLanguage;
+        menuMuted = isMuted;
+    }
+
+    // The glows go down first, over the black background, and the screen is added on top of them so the text
+    // stays in front as when the layers were drawn one by one
+    ClearBackground(BLACK);
+    float wave = sinf(gameTime * 2.0f);
+    int glowCount = CurrentQuality().menuGlow ? menuGlowCount : 0;
+    for (int i = 0; i < glowCount; i++)
+    {
+        Rectangle bounds = menuGlows[i].bounds;
+        float width = bounds.width * (1 + menuGlows[i].pulse.x * wave);
+        float height = bounds.height * (1 + menuGlows[i].pulse.y * wave);
+        Rectangle source = {bounds.x, screenHeight - bounds.y - bounds.height, bounds.width, -bounds.height};
+        Rectangle dest = {bounds.x + (bounds.width - width) / 2, bounds.y + (bounds.height - height) / 2, width,
+                          height};
+        drawListTexture(LAYER_BACKGROUND, menuGlowTexture.texture, source, dest, WHITE, BLEND_ALPHA);
     }
 
-    case HOW_TO_PLAY: {
-        ClearBackground(BLACK);
-        Vector2 textPos;
-        float glowScale = 1.0f + 0.1f * sinf(gameTime * 2.0f);
-        int glowLayers = 3;
-
-        const char *manualText;
-        const char *playText;
-        const char *tetrisText = "Tetris:";
-        const char *moveText;
-        const char *rotateText;
-        const char *fallText;
-        const char *gridText;
-        const char *playerGameText;
-        const char *movePlayerText;
-        const char *jumpText;
-        const char *doorText;
-        const char *timeText;
-
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            manualText = "Manual do Usuario";
-            playText = "(Pressione ENTER para Jogar)";
-            moveText = "Use setas para mover";
-            rotateText = "Pressione <CIMA> para girar";
-            fallText = "Pressione <BAIXO> para queda rapida e <ESPACO> para queda livre";
-            gridText = "Pressione <G> para fazer o tabuleiro desaparecer ou vice-versa";
-            playerGameText = "Jogo do Jogador:";
-            movePlayerText = "Use setas para mover";
-            jumpText = "Use <ESPACO> para pular";
-            doorText = "Move o jogador contra a porta para passar de nivel";
-            timeText = "So tem um tempo limitado para mover o jogador contra a porta (10s)";
-            break;
-        case GERMAN:
-            manualText = "Benutzerhandbuch";
-            playText = "(Druecke ENTER zum Spielen)";
-            moveText = "Pfeiltasten zum Bewegen verwenden";
-            rotateText = "Druecke <HOCH> zum Drehen";
-            fallText = "Druecke <RUNTER> fuer schnelles Fallen und <LEERTASTE> fuer "
-                       "freien Fall";
-            gridText = "Druecke <G> um das Gitternetz verschwinden zu lassen oder andersherum";
-            playerGameText = "Spielerspiel:";
-            movePlayerText = "Pfeiltasten zum Bewegen verwenden";
-            jumpText = "Verwende <LEERTASTE> zum Springen";
-            doorText = "Bewege den Spieler gegen die Tuer, um das Level zu bestehen";
-            timeText = "Man hat nur eine begrenzte Zeit den Spieler gegen die Tuer zu bewegen(10s) ";
-            break;
-        case ENGLISH:
-        default:
-            manualText = "User Manual";
-            playText = "(Press ENTER to Play)";
-            moveText = "Use arrows to move";
-            rotateText = "Press <UP> to rotate";
-            fallText = "Press <DOWN> for fast fall and <SPACE> for free fall";
-            gridText = "Press <G> to make the grid disappear or the other way around";
-            playerGameText = "Player Game:";
-            movePlayerText = "Use arrows to move";
-            jumpText = "Use <SPACE> to jump";
-            doorText = "Move the player against the door to pass the level";
-            timeText = "You only have a limited time to move the player against the door(10s)";
-            break;
-        }
+    drawListTexture(LAYER_SCENE, menuTexture.texture, {0, 0, (float)screenWidth, -(float)screenHeight},
+                    {0, 0, (float)screenWidth, (float)screenHeight}, WHITE, BLEND_ADDITIVE);
+}
 
-        textPos = {(float)screenWidth / 2 - MeasureTextEx(font, manualText, 40, 1).x / 2,
-                   (float)screenHeight / 2 - 240};
+int const PACING_PANEL_WIDTH = PACING_WINDOW + 20;
+int const PACING_PANEL_HEIGHT = 150;
+int const PACING_GRAPH_HEIGHT = 40; // Two frame budgets tall
+float const PACING_TEXT_SIZE = 16;
 
-        for (int i = glowLayers; i >= 1; i--)
-        {
-            float glowSize = 40 + i * 10 * glowScale;
-            float glowAlpha = 0.3f - (i * 0.08f);
-            Color glowColor = {255, 255, 0, (unsigned char)(glowAlpha * 255)};
-            Vector2 glowPos = {(float)screenWidth / 2 - MeasureTextEx(font, manualText, glowSize, 1).x / 2,
-                               (float)screenHeight / 2 - 240 - i * 2};
-            DrawTextEx(font, manualText, glowPos, glowSize, 1, glowColor);
-        }
-        DrawTextEx(font, manualText, textPos, 40, 1, WHITE);
-
-        DrawTextEx(font, playText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playText, 35, 1).x / 2,
-                             (float)screenHeight / 2 - 125},
-                   35, 1, WHITE);
-        DrawTextEx(font, tetrisText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, tetrisText, 35, 1).x / 2,
-                             (float)screenHeight / 2 - 65},
-                   35, 1, WHITE);
-        DrawTextEx(font, moveText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, moveText, 25, 1).x / 2,
-                             (float)screenHeight / 2 - 25},
-                   25, 1, WHITE);
-        DrawTextEx(
-            font, rotateText,
-            (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, rotateText, 25, 1).x / 2, (float)screenHeight / 2},
-            25, 1, WHITE);
-        DrawTextEx(font, fallText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, fallText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 25},
-                   25, 1, WHITE);
-        DrawTextEx(font, gridText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, gridText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 50},
-                   25, 1, WHITE);
-        DrawTextEx(font, playerGameText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playerGameText, 35, 1).x / 2,
-                             (float)screenHeight / 2 + 100},
-                   35, 1, WHITE);
-        DrawTextEx(font, movePlayerText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, movePlayerText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 140},
-                   25, 1, WHITE);
-        DrawTextEx(font, jumpText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, jumpText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 165},
-                   25, 1, WHITE);
-        DrawTextEx(font, doorText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, doorText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 190},
-                   25, 1, WHITE);
-        DrawTextEx(font, timeText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, timeText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 215},
-                   25, 1, WHITE);
-        break;
+// Frame pacing of the last full rate frames, bottom left: the numbers above a bar per frame, newest on the right
+void DrawPacingOverlay()
+{
+    float budget = 1.0f / fullRateFps;
+    PacingStats stats = pacingStats(framePacing, budget);
+    Rectangle panel = {10, (float)screenHeight - PACING_PANEL_HEIGHT - 10, PACING_PANEL_WIDTH, PACING_PANEL_HEIGHT};
+    // A layer down, so the text and bars draw over it whichever texture the font is in
+    drawListRectangle(LAYER_EFFECTS, panel, Fade(BLACK, 0.7f));
+
+    char const *lines[4];
+    if (targetFps > 0)
+        lines[0] = TextFormat("%d fps target, %.0f fps", targetFps, stats.average > 0 ? 1 / stats.average : 0);
+    else
+        lines[0] = TextFormat("Uncapped, %.0f fps", stats.average > 0 ? 1 / stats.average : 0);
+    lines[1] = TextFormat("avg %.2f  99%% %.2f  worst %.2f ms", 1000 * stats.average, 1000 * stats.percentile99,
+                          1000 * stats.worst);
+    lines[2] = TextFormat("jitter %.2f ms, %d of %d late", 1000 * stats.jitter, stats.lateFrames, stats.frames);
+    lines[3] = TextFormat("%d draws in %d batches, %d vertices", lastDrawStats.commands, lastDrawStats.batches,
+                          lastDrawStats.vertices);
+    for (int i = 0; i < 4; i++)
+    {
+        drawListText(LAYER_TEXT, font, lines[i], {panel.x + 10, panel.y + 8 + i * (PACING_TEXT_SIZE + 4)},
+                     PACING_TEXT_SIZE, 1, WHITE);
     }
 
-    case RULES: {
-        ClearBackground(BLACK);
-        Vector2 textPos;
-        float glowScale = 2.0f + 0.1f * sinf(gameTime * 2.0f);
-        int glowLayers = 3;
-
-        const char *rulesText;
-        const char *playText;
-        const char *tetrisText = "Tetris:";
-        const char *fullLinesText;
-        const char *gridFullText;
-        const char *playerGameText;
-        const char *dieText;
-        const char *hitWallText;
-        const char *doorText;
-
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            rulesText = "Regras";
-            playText = "(Pressione ENTER para Jogar)";
-            fullLinesText = "Se uma linha inteira estiver cheia, ela sera removida";
-            gridFullText = "Se os Tetrominos ja nao caberem no tabuleiro, morreras";
-            playerGameText = "Jogo do Jogador:";
-            dieText = "Se caires entra as plataformas, morreras";
-            hitWallText = "Se moveres o jogador contra as paredes, morreras";
-            doorText = "Mova o jogador contra a porta para passar de nivel";
-            break;
-        case GERMAN:
-            rulesText = "Regeln";
-            playText = "(Druecke Enter zum Spielen)";
-            fullLinesText = "Wenn eine ganze Linie voll ist, wird sie geloescht";
-            gridFullText = "Wenn die Tetrominos nicht mehr ins Feld passen verlierst du";
-            playerGameText = "Spielerspiel";
-            dieText = "Wenn du zwischen die Platformen faellst stirbst du";
-            hitWallText = "Wenn du den Spieler gegen die Waende bewegst stirbst du";
-            doorText = "Bewege den Spieler gegen die Tuer, um das Level zu bestehen";
-            break;
-        case ENGLISH:
-        default:
-            rulesText = "Rules";
-            playText = "(Press ENTER to play)";
-            fullLinesText = "If a line is full it's deleted";
-            gridFullText = "If your Tetrominos are stacked to high, you die";
-            playerGameText = "Player Game:";
-            dieText = "If the player falls between the platforms you die";
-            hitWallText = "If you move the player against the walls you'll die";
-            doorText = "Move the player against the door to pass the level";
-            break;
-        }
+    float graphBottom = panel.y + panel.height - 10;
+    for (int age = 0; age < framePacing.count; age++)
+    {
+        float frameTime = frameTimeAt(framePacing, age);
+        float height = fminf(frameTime / (2 * budget), 1.0f) * PACING_GRAPH_HEIGHT;
+        Color color = frameTime > PACING_LATE_FRAME * budget ? RED : LIME;
+        drawListRectangle(LAYER_TEXT, {panel.x + 10 + PACING_WINDOW - 1 - age, graphBottom - height, 1, height},
+                          color);
+    }
+    // The budget, halfway up the graph
+    drawListRectangle(LAYER_TEXT, {panel.x + 10, graphBottom - PACING_GRAPH_HEIGHT / 2, PACING_WINDOW, 1},
+                      Fade(WHITE, 0.5f));
+}
 
-        textPos = {(float)screenWidth / 2 - MeasureTextEx(font, rulesText, 40, 1).x / 2, (float)screenHeight / 2 - 235};
+void UpdateDrawFrame(float gameTime)
+{
+    BeginDrawing();
+    drawListBegin();
+    UpdateLanguageSelection(); // Check for language button clicks
 
-        for (int i = glowLayers; i >= 1; i--)
-        {
-            float glowSize = 40 + i * 5 * glowScale;
-            float glowAlpha = 0.3f - (i * 0.1f);
-            Color glowColor = {255, 255, 0, (unsigned char)(glowAlpha * 255)};
-            Vector2 glowPos = {(float)screenWidth / 2 - MeasureTextEx(font, rulesText, glowSize, 1).x / 2,
-                               (float)screenHeight / 2 - 240 - i * 2};
-            DrawTextEx(font, rulesText, glowPos, glowSize, 1, glowColor);
-        }
-        DrawTextEx(font, rulesText, textPos, 40, 1, WHITE);
-
-        DrawTextEx(font, playText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playText, 35, 1).x / 2,
-                             (float)screenHeight / 2 - 105},
-                   35, 1, WHITE);
-        DrawTextEx(font, tetrisText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, tetrisText, 35, 1).x / 2,
-                             (float)screenHeight / 2 - 40},
-                   35, 1, WHITE);
-        DrawTextEx(
-            font, playText,
-            (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playText, 25, 1).x / 2, (float)screenHeight / 2}, 25,
-            1, WHITE);
-        DrawTextEx(font, fullLinesText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, fullLinesText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 25},
-                   25, 1, WHITE);
-        DrawTextEx(font, gridFullText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, gridFullText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 50},
-                   25, 1, WHITE);
-        DrawTextEx(font, playerGameText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playerGameText, 35, 1).x / 2,
-                             (float)screenHeight / 2 + 100},
-                   35, 1, WHITE);
-        DrawTextEx(font, dieText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, dieText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 140},
-                   25, 1, WHITE);
-        DrawTextEx(font, hitWallText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, hitWallText, 25, 1).x / 2,
-                             (float)screenHeight / 2 + 165},
-                   25, 1, WHITE);
-        DrawTextEx(font, playText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playText, 35, 1).x / 2,
-                             (float)screenHeight / 2 - 105},
-                   35, 1, WHITE);
-        DrawTextEx(font, doorText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, doorText, 35, 1).x / 2 + 110,
-                             (float)screenHeight / 2 + 190},
-                   25, 1, WHITE);
+    switch (gameState)
+    {
+    case HOME:
+    case HOW_TO_PLAY:
+    case RULES:
+        DrawMenuScreen(gameTime);
         break;
-    }
 
     case PLAYING: {
         ClearBackground(playingBackground);
-        UpdateGame();
         DrawGrid();
 
-        const char *scoreText;
-        const char *levelText;
-        const char *linesText;
-        const char *nextLevelText;
-        const char *advanceText;
-        const char *levelUpText;
-        const char *soundText;
-        const char *onOffText;
-        const char *pauseText;
-        const char *gameOverText;
-
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            scoreText = TextFormat("Pontuacao: %i", score);
-            levelText = TextFormat("Nivel: %i", level);
-            linesText = TextFormat("Linhas: %i", linesClearedThisLevel);
-            nextLevelText = TextFormat("Proximo Nivel: %i/%i linhas", linesClearedThisLevel, level * level);
-            advanceText = "Limpe linhas para avancar!";
-            levelUpText = "Subir de Nivel!";
-            soundText = "Som:";
-            onOffText = isMuted ? "DESLIGADO" : "LIGADO";
-            pauseText = "JOGO PAUSADO";
-            gameOverText = "Fim de Jogo";
-            break;
-        case GERMAN:
-            scoreText = TextFormat("Punkte: %i", score);
-            levelText = TextFormat("Stufe: %i", level);
-            linesText = TextFormat("Linien: %i", linesClearedThisLevel);
-            nextLevelText = TextFormat("Naechste Stufe: %i/%i Linien", linesClearedThisLevel, level * level);
-            advanceText = "Loesche Linien zum Fortfahren!";
-            levelUpText = "Stufe Aufstieg!";
-            soundText = "Ton:";
-            onOffText = isMuted ? "AUS" : "AN";
-            pauseText = "SPIEL PAUSIERT";
-            gameOverText = "Spiel Ende";
-            break;
-        case ENGLISH:
-        default:
-            scoreText = TextFormat("Score: %i", score);
-            levelText = TextFormat("Level: %i", level);
-            linesText = TextFormat("Lines: %i", linesClearedThisLevel);
-            nextLevelText = TextFormat("Next Level: %i/%i lines", linesClearedThisLevel, level * level);
-            advanceText = "Clear lines to advance!";
-            levelUpText = "Level Up!";
-            soundText = "Sound:";
-            onOffText = isMuted ? "OFF" : "ON";
-            pauseText = "GAME PAUSED";
-            gameOverText = "Game Over";
-            break;
-        }
-
-        DrawTextEx(font, scoreText, (Vector2){20, 60}, 30, 1, BLACK);
-        DrawTextEx(font, levelText, (Vector2){20, 20}, 30, 1, BLACK);
-        DrawTextEx(font, linesText, (Vector2){20, 100}, 30, 1, BLACK);
-        DrawTextEx(font, nextLevelText, (Vector2){20, 140}, 27, 1, DARKGRAY);
-
-        int linesNeeded = level * level;
-        if (linesClearedThisLevel < linesNeeded)
+        const char *scoreText = TextFormat(Localized(STR_SCORE), game.score);
+        const char *levelText = TextFormat(Localized(STR_LEVEL), game.level);
+        const char *linesText = TextFormat(Localized(STR_LINES), game.linesClearedThisLevel);
+        const char *nextLevelText =
+            TextFormat(Localized(STR_NEXT_LEVEL), game.linesClearedThisLevel, game.level * game.level);
+        const char *advanceText = Localized(STR_ADVANCE);
+        const char *levelUpText = Localized(STR_LEVEL_UP);
+        const char *pauseText = Localized(STR_PAUSED);
+        const char *gameOverText = Localized(STR_GAME_OVER);
+
+        drawListText(LAYER_TEXT, font, scoreText, (Vector2){20, 60}, 30, 1, BLACK);
+        drawListText(LAYER_TEXT, font, levelText, (Vector2){20, 20}, 30, 1, BLACK);
+        drawListText(LAYER_TEXT, font, linesText, (Vector2){20, 100}, 30, 1, BLACK);
+        drawListText(LAYER_TEXT, font, nextLevelText, (Vector2){20, 140}, 27, 1, DARKGRAY);
+
+        int linesNeeded = game.level * game.level;
+        if (game.linesClearedThisLevel < linesNeeded)
         {
-            DrawTextEx(font, advanceText, (Vector2){20, 180}, 20, 1, GRAY);
+            drawListText(LAYER_TEXT, font, advanceText, (Vector2){20, 180}, 20, 1, GRAY);
         }
         else
         {
-            DrawTextEx(font, levelUpText, (Vector2){20, 180}, 20, 1, GREEN);
+            drawListText(LAYER_TEXT, font, levelUpText, (Vector2){20, 180}, 20, 1, GREEN);
         }
 
-        float progress = (float)linesClearedThisLevel / linesNeeded;
+        float progress = (float)game.linesClearedThisLevel / linesNeeded;
         if (progress > 1.0f)
             progress = 1.0f;
-        DrawRectangle(20, 200, 200, 20, GRAY);
-        DrawRectangle(20, 200, 200 * progress, 20, DARKGREEN);
+        drawListRectangle(LAYER_SCENE, {20, 200, 200, 20}, GRAY);
+        drawListRectangle(LAYER_SCENE, {20, 200, 200 * progress, 20}, DARKGREEN);
 
         static float bonusTimer = 0.0f;
         if (justClearedGrid)
@@ -1828,37 +1674,33 @@ void UpdateDrawFrame(float gameTime)
         }
         if (bonusTimer > 0)
         {
-            const char *bonusText = currentLanguage == PORTUGUESE ? "+50 Bonus de Limpeza de tabuleiro!"
-                                    : currentLanguage == GERMAN   ? "+50 Bonus fuer Gitterloesung!"
-                                                                  : "+50 Grid Clear Bonus!";
-            DrawTextEx(font, bonusText, (Vector2){(float)screenWidth / 2 - 135, (float)screenHeight / 2 + 5}, 25, 1,
-                       BLACK);
+            drawListText(LAYER_TEXT, font, Localized(STR_GRID_BONUS),
+                         (Vector2){(float)screenWidth / 2 - 135, (float)screenHeight / 2 + 5}, 25, 1, BLACK);
             bonusTimer -= GetFrameTime();
         }
 
-        DrawPiece(&currentPiece);
-        UpdateDrawParticles(GetFrameTime());
+        float pieceAlpha = snapshotAlpha(game);
+        DrawPiece(game.previousPiece, game.currentPiece, pieceAlpha, fallProgress(game, pieceAlpha));
+        updateParticles(particles, GetFrameTime());
+        drawListCustom(LAYER_EFFECTS, GetShapesTexture().id, 4 * particles.count, DrawParticleBatch, nullptr);
         DrawPulseEffect(GetFrameTime());
 
-        if (pause)
+        if (game.paused)
         {
-            DrawTextEx(font, pauseText,
-                       (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, pauseText, 40, 1).x / 2,
-                                 (float)screenHeight / 2 - 40},
-                       40, 1, BLACK);
+            drawListText(LAYER_TEXT, font, pauseText,
+                         (Vector2){CenteredX(STR_PAUSED, 40),
+                                   (float)screenHeight / 2 - 40},
+                         40, 1, BLACK);
         }
-        if (gameOver)
+        if (game.phase == PHASE_OVER)
         {
-            DrawTextEx(font, gameOverText,
-                       (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, gameOverText, 40, 1).x / 2,
-                                 (float)screenHeight / 2 - 20},
-                       40, 1, BLACK);
+            drawListText(LAYER_TEXT, font, gameOverText,
+                         (Vector2){CenteredX(STR_GAME_OVER, 40),
+                                   (float)screenHeight / 2 - 20},
+                         40, 1, BLACK);
         }
 
-        // Draw mute/unmute button
-        DrawTextEx(font, soundText, (Vector2){muteButton.x + 7, muteButton.y - 15}, 17, 1, WHITE);
-        DrawRectangleRec(muteButton, isMuted ? RED : DARKGREEN);
-        DrawTextEx(font, onOffText, (Vector2){muteButton.x + 5, muteButton.y + 10}, 20, 1, WHITE);
+        DrawMuteButton();
         break;
     }
 
@@ -1872,179 +1714,92 @@ void UpdateDrawFrame(float gameTime)
             else
             {
                 float shakeIntensity = shakeTimer / SHAKE_DURATION * 10.0f;
-                shakeOffset.x = (float)GetRandomValue(-shakeIntensity, shakeIntensity);
-                shakeOffset.y = (float)GetRandomValue(-shakeIntensity, shakeIntensity);
+                int shakeRange = (int)shakeIntensity;
+                shakeOffset.x = (float)randomRange(cosmeticRng(COSMETIC_SHAKE), -shakeRange, shakeRange);
+                shakeOffset.y = (float)randomRange(cosmeticRng(COSMETIC_SHAKE), -shakeRange, shakeRange);
             }
         }
 
         ClearBackground(DARKBLUE);
-        for (int i = 0; i < MAX_STARS; i++)
-        {
-            DrawCircleV(stars[i], GetRandomValue(1, 3), WHITE);
-        }
-
-        UpdateLevelTransition(GetFrameTime());
+        starfieldFrame = {gameTime, shakeOffset, CurrentQuality().twinklingStars};
+        drawListCustom(LAYER_BACKGROUND, GetShapesTexture().id, 4 * starfield.count, DrawStarfieldBatch,
+                       &starfieldFrame);
 
+        // The shake moves the whole scene, everything in it coming from spriteTexture
+        drawListOffset(shakeOffset);
         for (int i = 0; i < NUM_PLATFORMS; i++)
         {
-            Rectangle platformRect = {platforms[i].position.x - platforms[i].width / 2 + shakeOffset.x,
-                                      platforms[i].position.y - platforms[i].height / 2 + shakeOffset.y,
-                                      platforms[i].width, platforms[i].height};
-            DrawRectangleRounded(platformRect, 1.2f, 8, MAROON);
+            DrawBakedSprite(bakedPlatform, {game.platforms[i].position.x, game.platforms[i].position.y}, WHITE);
         }
 
-        Rectangle doorRect = {door.position.x - door.width / 2 + shakeOffset.x, door.position.y - door.height / 2,
-                              door.width + shakeOffset.y, door.height};
+        DrawBakedSprite(bakedDoor,
+                        {game.door.position.x - game.door.width / 2, game.door.position.y - game.door.height / 2},
+                        WHITE);
 
-        Rectangle shadowRect = {doorRect.x + 10 + shakeOffset.x, doorRect.y + 5 + shakeOffset.y, doorRect.width,
-                                doorRect.height};
-        DrawRectangleRec(shadowRect, (Color){0, 0, 0, 50});
-
-        Rectangle frameRect = {doorRect.x - 4 + shakeOffset.x, doorRect.y - 4 + shakeOffset.y, doorRect.width + 8,
-                               doorRect.height + 8};
-        DrawRectangleRec(frameRect, (Color){139, 69, 19, 255});
-
-        DrawRectangleRec(doorRect, (Color){165, 42, 42, 255});
-
-        Rectangle topPanel = {doorRect.x + 4 + shakeOffset.x, doorRect.y + 4 + shakeOffset.y, doorRect.width - 8,
-                              (doorRect.height - 12) / 2};
-        Rectangle bottomPanel = {doorRect.x + 4 + shakeOffset.x, doorRect.y + doorRect.height / 2 + 2 + shakeOffset.y,
-                                 doorRect.width - 8, (doorRect.height - 12) / 2};
-        DrawRectangleRec(topPanel, (Color){139, 69, 19, 255});
-        DrawRectangleRec(bottomPanel, (Color){139, 69, 19, 255}); // Note: bottomPanel should be used here
-                                                                  // instead of customPanel
-
-        Vector2 handlePos = {doorRect.x + doorRect.width - 6 + shakeOffset.x,
-                             doorRect.y + doorRect.height * 0.6f + shakeOffset.y};
-        DrawCircleV(handlePos, 2.0f, GOLD);
-        DrawCircleLines(handlePos.x, handlePos.y, 2.0f, BLACK);
-
-        if (isPlayerVisible)
+        if (!game.doorHit) // The player vanishes into the door
         {
-            for (int i = 0; i < player.size; i++)
+            float alpha = snapshotAlpha(game);
+            Vector2 playerPos = {game.previousPlayerPosition.x +
+                                     (game.player.position.x - game.previousPlayerPosition.x) * alpha,
+                                 game.previousPlayerPosition.y +
+                                     (game.player.position.y - game.previousPlayerPosition.y) * alpha};
+            if (game.isElectrocuted)
             {
-                Vector2 unitPos = {player.position.x + player.units[i].position.x - player.unitSize / 2,
-                                   player.position.y + player.units[i].position.y - player.unitSize / 2};
-                Color drawColor = player.units[i].color;
-                if (isElectrocuted)
-                {
-                    drawColor = (fmod(GetTime(), 0.2f) < 0.1f) ? YELLOW : BLUE;
-                    drawColor.a = (unsigned char)(255 * (electrocutionTimer / ELECTROCUTION_DURATION));
-                }
-
-                if (i == 0)
-                {
-                    Rectangle headRect = {unitPos.x - player.units[i].width / 2, unitPos.y - player.units[i].height / 2,
-                                          player.units[i].width, player.units[i].height};
-                    DrawRectangleRounded(headRect, 0.8f, 8, drawColor);
-                }
-                else if (i == 2 || i == 3)
-                {
-                    Rectangle armRect = {unitPos.x, unitPos.y, player.units[i].width, player.units[i].height};
-                    DrawRectanglePro(armRect, {player.units[i].width / 2, player.units[i].height / 2}, 35.0f,
-                                     drawColor);
-                }
-                else
-                {
-                    Rectangle rect = {unitPos.x - player.units[i].width / 2, unitPos.y - player.units[i].height / 2,
-                                      player.units[i].width, player.units[i].height};
-                    DrawRectangleRec(rect, drawColor);
-                }
+                Color flash = (fmod(GetTime(), 0.2f) < 0.1f) ? YELLOW : BLUE;
+                flash.a = (unsigned char)(255 * (game.electrocutionTimer / ELECTROCUTION_DURATION));
+                DrawBakedSprite(bakedSilhouette, playerPos, flash);
+            }
+            else
+            {
+                DrawBakedSprite(bakedPlayer, playerPos, WHITE);
             }
         }
+        drawListOffset({0, 0});
 
-        UpdateDrawParticles(GetFrameTime());
+        updateParticles(particles, GetFrameTime());
+        drawListCustom(LAYER_EFFECTS, GetShapesTexture().id, 4 * particles.count, DrawParticleBatch, nullptr);
         DrawPulseEffect(GetFrameTime());
 
-        const char *timeText;
-        const char *pauseText;
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            timeText = TextFormat("Tempo Restante: %.1f", transitionTimer >= 0 ? transitionTimer : 0.0f);
-            pauseText = "JOGO PAUSADO";
-            break;
-        case GERMAN:
-            timeText = TextFormat("Verbleibende Zeit: %.1f", transitionTimer >= 0 ? transitionTimer : 0.0f);
-            pauseText = "SPIEL PAUSIERT";
-            break;
-        case ENGLISH:
-        default:
-            timeText = TextFormat("Time Left: %.1f", transitionTimer >= 0 ? transitionTimer : 0.0f);
-            pauseText = "GAME PAUSED";
-            break;
-        }
+        const char *timeText =
+            TextFormat(Localized(STR_TIME_LEFT), game.transitionTimer >= 0 ? game.transitionTimer : 0.0f);
+        const char *pauseText = Localized(STR_PAUSED);
 
-        DrawTextEx(font, timeText, (Vector2){20, 20}, 20, 1, WHITE);
-        if (pause)
+        drawListText(LAYER_TEXT, font, timeText, (Vector2){20, 20}, 20, 1, WHITE);
+        if (game.paused)
         {
-            DrawTextEx(font, pauseText,
-                       (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, pauseText, 40, 1).x / 2,
-                                 (float)screenHeight / 2 - 40},
-                       40, 1, WHITE);
+            drawListText(LAYER_TEXT, font, pauseText,
+                         (Vector2){CenteredX(STR_PAUSED, 40),
+                                   (float)screenHeight / 2 - 40},
+                         40, 1, WHITE);
         }
         break;
     }
 
     case GAME_OVER: {
         ClearBackground((Color){0, 0, 0, 0});
-        const char *gameOverText;
-        const char *restartText;
-        const char *homeText;
-        const char *linesText;
-        const char *soundText;
-        const char *onOffText;
-
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            gameOverText = "Fim de Jogo";
-            restartText = "Pressione [ENTER] para Reiniciar";
-            homeText = "Pressione [H] para voltar ao Inicio";
-            linesText = TextFormat("Linhas Limpas: %i", linesClearedTotal);
-            soundText = "Som:";
-            onOffText = isMuted ? "DESLIGADO" : "LIGADO";
-            break;
-        case GERMAN:
-            gameOverText = "Spiel Ende";
-            restartText = "Druecke [ENTER] zum Neustart";
-            homeText = "Druecke [H] fuer Home";
-            linesText = TextFormat("Geloeschte Linien: %i", linesClearedTotal);
-            soundText = "Ton:";
-            onOffText = isMuted ? "AUS" : "AN";
-            break;
-        case ENGLISH:
-        default:
-            gameOverText = "Game Over";
-            restartText = "Press [ENTER] to Restart";
-            homeText = "Press [H] to return to Home";
-            linesText = TextFormat("Lines Cleared: %i", linesClearedTotal);
-            soundText = "Sound:";
-            onOffText = isMuted ? "OFF" : "ON";
-            break;
-        }
-
-        DrawTextEx(font, gameOverText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, gameOverText, 50, 1).x / 2,
-                             (float)screenHeight / 2 - 50},
-                   50, 1, WHITE);
-        DrawTextEx(font, restartText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, restartText, 20, 1).x / 2,
-                             (float)screenHeight / 2 + 10},
-                   20, 1, WHITE);
-        DrawTextEx(font, homeText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, homeText, 20, 1).x / 2,
-                             (float)screenHeight / 2 + 40},
-                   20, 1, WHITE);
-        DrawTextEx(font, linesText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, linesText, 25, 1).x / 2 - 10,
-                             (float)screenHeight / 2 + 77},
-                   25, 1, WHITE);
-
-        // Draw mute/unmute button
-        DrawTextEx(font, soundText, (Vector2){muteButton.x + 7, muteButton.y - 15}, 17, 1, WHITE);
-        DrawRectangleRec(muteButton, isMuted ? RED : DARKGREEN);
-        DrawTextEx(font, onOffText, (Vector2){muteButton.x + 5, muteButton.y + 10}, 20, 1, WHITE);
+        const char *gameOverText = Localized(STR_GAME_OVER);
+        const char *restartText = Localized(STR_RESTART);
+        const char *homeText = Localized(STR_RETURN_HOME);
+        const char *linesText = TextFormat(Localized(STR_LINES_CLEARED), game.linesClearedTotal);
+
+        drawListText(LAYER_TEXT, font, gameOverText,
+                     (Vector2){CenteredX(STR_GAME_OVER, 50),
+                               (float)screenHeight / 2 - 50},
+                     50, 1, WHITE);
+        drawListText(LAYER_TEXT, font, restartText,
+                     (Vector2){CenteredX(STR_RESTART, 20),
+                               (float)screenHeight / 2 + 10},
+                     20, 1, WHITE);
+        drawListText(LAYER_TEXT, font, homeText,
+                     (Vector2){CenteredX(STR_RETURN_HOME, 20),
+                               (float)screenHeight / 2 + 40},
+                     20, 1, WHITE);
+        drawListText(LAYER_TEXT, font, linesText,
+                     (Vector2){(float)screenWidth / 2 - measureTextCached(font, linesText, 25, 1).x / 2 - 10,
+                               (float)screenHeight / 2 + 77},
+                     25, 1, WHITE);
+
+        DrawMuteButton();
         break;
     }
 
@@ -2052,139 +1807,114 @@ void UpdateDrawFrame(float gameTime)
         ClearBackground(BLACK);
 
         // Language-specific text
-        const char *highScoreText;
-        const char *enterNameText;
-        const char *confirmText;
-        const char *playText;
-        const char *linesText;
-        const char *soundText;
-        const char *onOffText;
-
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            highScoreText = "Novo Recorde!";
-            enterNameText = "Insira o seu nome:";
-            confirmText = "Pressione <ENTER> para confirmar";
-            playText = "Pressione <Enter> outra vez para jogar";
-            linesText = TextFormat("Linhas Limpas: %i", linesClearedTotal);
-            soundText = "Som:";
-            onOffText = isMuted ? "DESLIGADO" : "LIGADO";
-            break;
-        case GERMAN:
-            highScoreText = "Neuer Highscore!";
-            enterNameText = "Gib deinen Namen ein:";
-            confirmText = "Druecke <ENTER> zum Bestaetigen";
-            playText = "Druecke noch einmal <Enter> zum Spielen";
-            linesText = TextFormat("Geloeschte Linien: %i", linesClearedTotal);
-            soundText = "Ton:";
-            onOffText = isMuted ? "AUS" : "AN";
-            break;
-        case ENGLISH:
-        default:
-            highScoreText = "New High Score!";
-            enterNameText = "Enter your name:";
-            confirmText = "Press <ENTER> to confirm";
-            playText = "Press <ENTER> again to play";
-            linesText = TextFormat("Lines Cleared: %i", linesClearedTotal);
-            soundText = "Sound:";
-            onOffText = isMuted ? "OFF" : "ON";
-            break;
-        }
-
-        // Draw high score header
-        DrawTextEx(font, highScoreText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, highScoreText, 50, 1).x / 2,
-                             (float)screenHeight / 2 - 110},
-                   50, 1, GOLD);
-
-        // Draw score
-        DrawTextEx(font, linesText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, linesText, 25, 1).x / 2,
-                             (float)screenHeight / 2 - 50},
-                   25, 1, WHITE);
+        const char *highScoreText = Localized(STR_NEW_HIGH_SCORE);
+        const char *enterNameText = Localized(STR_ENTER_NAME);
+        const char *confirmText = Localized(STR_CONFIRM_NAME);
+        const char *playText = Localized(STR_PLAY_AGAIN);
+        const char *linesText = TextFormat(Localized(STR_LINES_CLEARED), game.linesClearedTotal);
+
+        // Draw high game.score header
+        drawListText(LAYER_TEXT, font, highScoreText,
+                     (Vector2){CenteredX(STR_NEW_HIGH_SCORE, 50),
+                               (float)screenHeight / 2 - 110},
+                     50, 1, GOLD);
+
+        // Draw game.score
+        drawListText(LAYER_TEXT, font, linesText,
+                     (Vector2){(float)screenWidth / 2 - measureTextCached(font, linesText, 25, 1).x / 2,
+                               (float)screenHeight / 2 - 50},
+                     25, 1, WHITE);
 
         // Draw enter name prompt
-        DrawTextEx(font, enterNameText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, enterNameText, 25, 1).x / 2,
-                             (float)screenHeight / 2 - 10},
-                   25, 1, WHITE);
+        drawListText(LAYER_TEXT, font, enterNameText,
+                     (Vector2){CenteredX(STR_ENTER_NAME, 25),
+                               (float)screenHeight / 2 - 10},
+                     25, 1, WHITE);
 
         // Draw input box
-        DrawRectangle(screenWidth / 2 - 150, screenHeight / 2 + 20, 300, 40, Color{50, 50, 50, 255});
-        DrawRectangleLinesEx((Rectangle){(float)screenWidth / 2 - 150, (float)screenHeight / 2 + 20, 300, 40}, 2, GOLD);
+        Rectangle inputBox = {(float)screenWidth / 2 - 150, (float)screenHeight / 2 + 20, 300, 40};
+        drawListRectangle(LAYER_SCENE, inputBox, Color{50, 50, 50, 255});
+        drawListRectangleLines(LAYER_SCENE, inputBox, 2, GOLD);
 
         // Draw current name
-        DrawTextEx(font, playerName,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playerName, 30, 1).x / 2,
-                             (float)screenHeight / 2 + 25},
-                   30, 1, WHITE);
+        drawListText(LAYER_TEXT, font, playerName,
+                     (Vector2){(float)screenWidth / 2 - measureTextCached(font, playerName, 30, 1).x / 2,
+                               (float)screenHeight / 2 + 25},
+                     30, 1, WHITE);
 
         // Draw blinking cursor if text is less than max length
         if (showCursor && playerNameLength < NAME_LEN - 1)
         {
-            float cursorPosX = (float)screenWidth / 2 - MeasureTextEx(font, playerName, 30, 1).x / 2 +
-                               MeasureTextEx(font, playerName, 30, 1).x;
-            DrawTextEx(font, "_", (Vector2){cursorPosX, (float)screenHeight / 2 + 25}, 30, 1, WHITE);
+            float cursorPosX = (float)screenWidth / 2 + measureTextCached(font, playerName, 30, 1).x / 2;
+            drawListText(LAYER_TEXT, font, "_", (Vector2){cursorPosX, (float)screenHeight / 2 + 25}, 30, 1, WHITE);
         }
 
         // Draw confirmation text
-        DrawTextEx(font, confirmText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, confirmText, 20, 1).x / 2,
-                             (float)screenHeight / 2 + 80},
-                   25, 1, LIGHTGRAY);
-        DrawTextEx(font, playText,
-                   (Vector2){(float)screenWidth / 2 - MeasureTextEx(font, playText, 20, 1).x / 2,
-                             (float)screenHeight / 2 + 120},
-                   25, 1, LIGHTGRAY);
-
-        // Draw mute/unmute button
-        DrawTextEx(font, soundText, (Vector2){muteButton.x + 7, muteButton.y - 15}, 17, 1, WHITE);
-        DrawRectangleRec(muteButton, isMuted ? RED : DARKGREEN);
-        DrawTextEx(font, onOffText, (Vector2){muteButton.x + 5, muteButton.y + 10}, 20, 1, WHITE);
+        drawListText(LAYER_TEXT, font, confirmText,
+                     (Vector2){CenteredX(STR_CONFIRM_NAME, 20),
+                               (float)screenHeight / 2 + 80},
+                     25, 1, LIGHTGRAY);
+        drawListText(LAYER_TEXT, font, playText,
+                     (Vector2){CenteredX(STR_PLAY_AGAIN, 20),
+                               (float)screenHeight / 2 + 120},
+                     25, 1, LIGHTGRAY);
 
-        // Draw top 5 scores on the right side
-        const char *highScoresTitle;
+        DrawMuteButton();
 
-        switch (currentLanguage)
-        {
-        case PORTUGUESE:
-            highScoresTitle = "Melhores Pontuacoes:";
-            break;
-        case GERMAN:
-            highScoresTitle = "Bestenliste:";
-            break;
-        case ENGLISH:
-        default:
-            highScoresTitle = "Top Scores:";
-            break;
-        }
+        // Draw top 5 scores on the right side
+        const char *highScoresTitle = Localized(STR_TOP_SCORES);
 
-        DrawTextEx(font, highScoresTitle, (Vector2){screenWidth - 250, 150}, 25, 1, GOLD);
+        drawListText(LAYER_TEXT, font, highScoresTitle, (Vector2){screenWidth - 250, 150}, 25, 1, GOLD);
 
         ScoreEntry *scores = getScores();
         for (int i = 0; i < MAX_SCORES; i++)
         {
-            DrawTextEx(font, TextFormat("%d. %s - %d", i + 1, scores[i].name, scores[i].linesCleared),
-                       (Vector2){screenWidth - 250, (float)190 + i * 30}, 20, 1, (i == 0) ? GOLD : WHITE);
+            drawListText(LAYER_TEXT, font, TextFormat("%d. %s - %d", i + 1, scores[i].name, scores[i].linesCleared),
+                         (Vector2){screenWidth - 250, (float)190 + i * 30}, 20, 1, (i == 0) ? GOLD : WHITE);
         }
 
         break;
     }
     }
 
+    if (showPacingOverlay)
+        DrawPacingOverlay();
+
     UpdateAudioMute();
+    drawListFlush();
+    DrawListStats const &drawStats = drawListStats();
+    lastDrawStats = drawStats;
+    drawTotals.frames++;
+    drawTotals.commands += drawStats.commands;
+    drawTotals.batches += drawStats.batches;
+    drawTotals.vertices += drawStats.vertices;
+    frameWorkTime = (float)(GetTime() - frameStartTime);
     EndDrawing();
 }
 
 void UnloadGame()
 {
-    UnloadFont(font);
+    if (fontInAtlas)
+        unloadFontGlyphs(font);
+    else
+        UnloadFont(font);
     UnloadSound(levelStartSound);
     UnloadSound(doorHitSound);
-    UnloadTexture(flagPortugal);
-    UnloadTexture(flagGermany);
-    UnloadTexture(flagUK);
+    UnloadRenderTexture(boardTexture);
+    UnloadRenderTexture(menuTexture);
+    UnloadRenderTexture(menuGlowTexture);
+    if (textureAtlas.id != 0)
+    {
+        UnloadTexture(textureAtlas);
+    }
+    else
+    {
+        UnloadTexture(flagPortugal.texture);
+        UnloadTexture(flagGermany.texture);
+        UnloadTexture(flagUK.texture);
+        UnloadTexture(spriteTexture);
+    }
+    unloadLanguagePack();
     CloseAudioDevice();
 }
 
@@ -2197,96 +1927,3 @@ Vector2 toGrid(Vector2 position)
 {
     return {position.x / BLOCK_SIZE, position.y / BLOCK_SIZE};
 }
-
-bool canMoveHorizontally(Tetromino currentPiece, int amount)
-{
-    if (isInFreeFall && currentPiece.pieceState != BOTTOMED)
-    {
-        return false;
-    }
-
-    for (int i = 0; i < currentPiece.size; i++)
-    {
-        // check Y
-        if (currentPiece.pieceState != BOTTOMED && currentPiece.units[i].position.y >= GRID_VERTICAL_SIZE - 1)
-        {
-            return false; // No lateral movement if touching ground
-        }
-    }
-
-    for (int i = 0; i < currentPiece.size; i++)
-    {
-        Vector2 newPos = currentPiece.units[i].position;
-        newPos.x += amount;
-
-        // check X
-        if (newPos.x < 0 || newPos.x >= GRID_HORIZONTAL_SIZE)
-        {
-            return false;
-        }
-        if (grid[(int)currentPiece.units[i].position.y][(int)newPos.x] == 1)
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
-
-Tetromino rotatePiece(Tetromino piece)
-{
-    Tetromino rotatedPiece = piece;
-    Vector2 pivot = piece.units[0].position;
-
-    for (int i = 1; i < rotatedPiece.size; i++)
-    {
-        float relativeX = rotatedPiece.units[i].position.x - pivot.x;
-        float relativeY = rotatedPiece.units[i].position.y - pivot.y;
-
-        float newRelativeX = relativeY;
-        float newRelativeY = -relativeX;
-
-        rotatedPiece.units[i].position.x = pivot.x + newRelativeX;
-        rotatedPiece.units[i].position.y = pivot.y + newRelativeY;
-
-        if (rotatedPiece.units[i].position.x < 0 || rotatedPiece.units[i].position.x >= GRID_HORIZONTAL_SIZE ||
-            rotatedPiece.units[i].position.y < 0 || rotatedPiece.units[i].position.y >= GRID_VERTICAL_SIZE)
-        {
-            return piece;
-        }
-    }
-    for (int i = 0; i < rotatedPiece.size; i++)
-    {
-        int x = (int)rotatedPiece.units[i].position.x;
-        int y = (int)rotatedPiece.units[i].position.y;
-
-        if (grid[y][x] == 1)
-        {
-            return piece;
-        }
-    }
-    return rotatedPiece;
-}
-
-bool canMoveDown(Tetromino piece)
-{
-    for (int i = 0; i < piece.size; i++)
-    {
-        float newY = piece.units[i].position.y + 1;
-        int x = (int)piece.units[i].position.x;
-
-        if (newY >= GRID_VERTICAL_SIZE || grid[(int)newY][x] == 1)
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-void moveDown(Tetromino &currentPiece)
-{
-    for (int i = 0; i < currentPiece.size; i++)
-    {
-        currentPiece.units[i].position.y += 1; // Move down
-    }
-}
@@ -0,0 +1,143 @@
+#include "particles.h"
+
+#include "cosmetic_rng.h"
+#include "rlgl_batch.h"
+
+#include <math.h>
+
+// Quads per rlgl batch flush, the default RL_DEFAULT_BATCH_BUFFER_ELEMENTS; up to this many particles are
+// one draw call
+static int const BATCH_QUADS = 8192;
+
+void clearParticles(ParticlePool &pool)
+{
+    pool.count = 0;
+}
+
+int emitParticles(ParticlePool &pool, ParticleEmitter const &emitter, int count)
+{
+    if (count > MAX_PARTICLES - pool.count)
+        count = MAX_PARTICLES - pool.count;
+
+    // Each attribute is filled in one batch straight into the pool's arrays
+    Rng &rng = cosmeticRng(COSMETIC_PARTICLES);
+    int first = pool.count;
+    float *positionX = pool.positionX + first;
+    float *positionY = pool.positionY + first;
+    float *velocityX = pool.velocityX + first;
+    float *velocityY = pool.velocityY + first;
+    if (emitter.shape == EMIT_RADIAL)
+    {
+        // Angles and speeds go into the velocity arrays first, then become vectors in place
+        fillRandomFloats(rng, velocityX, count, 0.0f, 2.0f * PI);
+        fillRandomFloats(rng, velocityY, count, emitter.minSpeed, emitter.maxSpeed);
+        for (int i = 0; i < count; i++)
+        {
+            float dirX = cosf(velocityX[i]);
+            float dirY = sinf(velocityX[i]);
+            float speed = velocityY[i];
+            positionX[i] = emitter.position.x + dirX * emitter.radius;
+            positionY[i] = emitter.position.y + dirY * emitter.radius;
+            velocityX[i] = dirX * speed;
+            velocityY[i] = dirY * speed;
+        }
+    }
+    else
+    {
+        fillRandomFloats(rng, velocityX, count, -emitter.maxSpeed, emitter.maxSpeed);
+        fillRandomFloats(rng, velocityY, count, -emitter.maxSpeed, emitter.maxSpeed);
+        for (int i = 0; i < count; i++)
+        {
+            positionX[i] = emitter.position.x;
+            positionY[i] = emitter.position.y;
+        }
+    }
+    fillRandomFloats(rng, pool.size + first, count, emitter.minSize, emitter.maxSize);
+    fillRandomFloats(rng, pool.life + first, count, emitter.minLife, emitter.maxLife);
+    for (int i = 0; i < count; i++)
+    {
+        pool.color[first + i] = (i % emitter.colorPeriod == 0) ? emitter.colors[0] : emitter.colors[1];
+    }
+    pool.count += count;
+    return count;
+}
+
+void updateParticles(ParticlePool &pool, float deltaTime)
+{
+    int count = pool.count;
+    float step = deltaTime * 60;
+
+    for (int i = 0; i < count; i++)
+    {
+        pool.positionX[i] += pool.velocityX[i] * step;
+        pool.positionY[i] += pool.velocityY[i] * step;
+        pool.life[i] -= deltaTime;
+    }
+
+    // The last live particle fills each hole, order does not matter for drawing
+    for (int i = count - 1; i >= 0; i--)
+    {
+        if (pool.life[i] > 0)
+            continue;
+
+        count--;
+        pool.positionX[i] = pool.positionX[count];
+        pool.positionY[i] = pool.positionY[count];
+        pool.velocityX[i] = pool.velocityX[count];
+        pool.velocityY[i] = pool.velocityY[count];
+        pool.life[i] = pool.life[count];
+        pool.size[i] = pool.size[count];
+        pool.color[i] = pool.color[count];
+    }
+    pool.count = count;
+}
+
+void drawParticles(ParticlePool const &pool, float rotation)
+{
+    if (pool.count == 0)
+        return;
+
+    // Every particle turns by the same angle, so the rotated axes are computed once for the whole pool
+    float angle = rotation * DEG2RAD;
+    float axisX = cosf(angle);
+    float axisY = sinf(angle);
+
+    // Same solid-colour texel the shape functions use, so the particles join their batch
+    Texture2D shapes = GetShapesTexture();
+    Rectangle texel = GetShapesTextureRectangle();
+    float u = (texel.x + texel.width / 2) / shapes.width;
+    float v = (texel.y + texel.height / 2) / shapes.height;
+
+    rlSetTexture(shapes.id);
+    for (int start = 0; start < pool.count; start += BATCH_QUADS)
+    {
+        int end = start + BATCH_QUADS < pool.count ? start + BATCH_QUADS : pool.count;
+        rlCheckRenderBatchLimit(4 * (end - start));
+
+        rlBegin(RL_QUADS);
+        for (int i = start; i < end; i++)
+        {
+            float alpha = pool.life[i] / PARTICLE_FADE_TIME;
+            Color color = pool.color[i];
+            rlColor4ub(color.r, color.g, color.b, (unsigned char)(color.a * (alpha < 1.0f ? alpha : 1.0f)));
+
+            // Half extents along the rotated x and y axes
+            float half = pool.size[i] / 2;
+            float ax = axisX * half;
+            float ay = axisY * half;
+            float x = pool.positionX[i];
+            float y = pool.positionY[i];
+
+            rlTexCoord2f(u, v);
+            rlVertex2f(x - ax + ay, y - ay - ax);
+            rlTexCoord2f(u, v);
+            rlVertex2f(x - ax - ay, y - ay + ax);
+            rlTexCoord2f(u, v);
+            rlVertex2f(x + ax - ay, y + ay + ax);
+            rlTexCoord2f(u, v);
+            rlVertex2f(x + ax + ay, y + ay - ax);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
@@ -0,0 +1,58 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+// Particle pool stored as structure of arrays: each attribute is one contiguous array, so the update loops
+// run straight through memory and vectorize, and drawing never touches velocities.
+
+#include "raylib.h"
+
+int const MAX_PARTICLES = 32768;
+
+struct ParticlePool
+{
+    int count;
+    float positionX[MAX_PARTICLES];
+    float positionY[MAX_PARTICLES];
+    float velocityX[MAX_PARTICLES]; // Pixels per 1/60 s
+    float velocityY[MAX_PARTICLES];
+    float life[MAX_PARTICLES]; // Seconds left, the particle fades out over its last PARTICLE_FADE_TIME
+    float size[MAX_PARTICLES];
+    Color color[MAX_PARTICLES];
+};
+
+float const PARTICLE_FADE_TIME = 1.5f;
+
+enum EmitterShape
+{
+    EMIT_RADIAL, // Outwards from the centre at a random angle, speed in [minSpeed, maxSpeed]
+    EMIT_BOX     // Each velocity axis independently in [-maxSpeed, maxSpeed]
+};
+
+// Describes one burst: where particles start, how they move and what they look like
+struct ParticleEmitter
+{
+    Vector2 position;
+    float radius; // Radial particles start this far out along their direction
+    EmitterShape shape;
+    float minSpeed;
+    float maxSpeed;
+    float minSize;
+    float maxSize;
+    float minLife;
+    float maxLife;
+    Color colors[2];
+    int colorPeriod; // Every colorPeriod-th particle gets colors[0], the others colors[1]
+};
+
+void clearParticles(ParticlePool &pool);
+
+// Spawns up to count particles, fewer if the pool is full. Returns how many were spawned.
+int emitParticles(ParticlePool &pool, ParticleEmitter const &emitter, int count);
+
+// Moves and ages every particle, then swap-removes the dead ones
+void updateParticles(ParticlePool &pool, float deltaTime);
+
+// Draws every particle as a square turned by rotation degrees, written straight into rlgl's vertex batch
+void drawParticles(ParticlePool const &pool, float rotation);
+
+#endif // !PARTICLES_H
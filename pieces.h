@@ -0,0 +1,148 @@
+#ifndef PIECES_H
+#define PIECES_H
+
+// Compile-time shape tables: every orientation of every tetromino as cell offsets from its pivot and as row
+// masks, so spawning, rotating and collision tests are lookups instead of per-cell arithmetic.
+//
+// Orientation r + 1 is orientation r turned a quarter around the pivot (offset (x, y) becomes (y, -x)),
+// the pivot being cell 0.
+
+#include "board.h"
+#include "generator.h"
+
+#include <stdint.h>
+
+int const PIECE_CELLS = 4;
+int const PIECE_ORIENTATIONS = 4;
+
+struct PieceShape
+{
+    int8_t cells[PIECE_CELLS][2]; // (x, y) offsets from the pivot, the pivot first
+    int8_t left;                  // Smallest x offset
+    int8_t top;                   // Smallest y offset
+    int8_t width;
+    int8_t height;
+    uint16_t rows[PIECE_MASK_ROWS]; // Cells of row top + r, bit 0 being column pivot + left
+    int8_t bottoms[PIECE_CELLS];    // y offset of the lowest cell in column pivot + left + c, for c < width
+};
+
+constexpr PieceShape PIECE_SHAPES[TOTAL_PIECES_TYPES][PIECE_ORIENTATIONS] = {
+    // I
+    {
+        {{{0, 0}, {-1, 0}, {1, 0}, {2, 0}}, -1, 0, 4, 1, {0xF, 0x0, 0x0, 0x0}, {0, 0, 0, 0}},
+        {{{0, 0}, {0, 1}, {0, -1}, {0, -2}}, 0, -2, 1, 4, {0x1, 0x1, 0x1, 0x1}, {1, 0, 0, 0}},
+        {{{0, 0}, {1, 0}, {-1, 0}, {-2, 0}}, -2, 0, 4, 1, {0xF, 0x0, 0x0, 0x0}, {0, 0, 0, 0}},
+        {{{0, 0}, {0, -1}, {0, 1}, {0, 2}}, 0, -1, 1, 4, {0x1, 0x1, 0x1, 0x1}, {2, 0, 0, 0}},
+    },
+    // J
+    {
+        {{{0, 0}, {0, 1}, {0, 2}, {-1, 2}}, -1, 0, 2, 3, {0x2, 0x2, 0x3, 0x0}, {2, 2, 0, 0}},
+        {{{0, 0}, {1, 0}, {2, 0}, {2, 1}}, 0, 0, 3, 2, {0x7, 0x4, 0x0, 0x0}, {0, 0, 1, 0}},
+        {{{0, 0}, {0, -1}, {0, -2}, {1, -2}}, 0, -2, 2, 3, {0x3, 0x1, 0x1, 0x0}, {0, -2, 0, 0}},
+        {{{0, 0}, {-1, 0}, {-2, 0}, {-2, -1}}, -2, -1, 3, 2, {0x1, 0x7, 0x0, 0x0}, {0, 0, 0, 0}},
+    },
+    // L
+    {
+        {{{0, 0}, {0, 1}, {0, 2}, {1, 2}}, 0, 0, 2, 3, {0x1, 0x1, 0x3, 0x0}, {2, 2, 0, 0}},
+        {{{0, 0}, {1, 0}, {2, 0}, {2, -1}}, 0, -1, 3, 2, {0x4, 0x7, 0x0, 0x0}, {0, 0, 0, 0}},
+        {{{0, 0}, {0, -1}, {0, -2}, {-1, -2}}, -1, -2, 2, 3, {0x3, 0x2, 0x2, 0x0}, {-2, 0, 0, 0}},
+        {{{0, 0}, {-1, 0}, {-2, 0}, {-2, 1}}, -2, 0, 3, 2, {0x7, 0x1, 0x0, 0x0}, {1, 0, 0, 0}},
+    },
+    // O
+    {
+        {{{0, 0}, {1, 0}, {0, 1}, {1, 1}}, 0, 0, 2, 2, {0x3, 0x3, 0x0, 0x0}, {1, 1, 0, 0}},
+        {{{0, 0}, {0, -1}, {1, 0}, {1, -1}}, 0, -1, 2, 2, {0x3, 0x3, 0x0, 0x0}, {0, 0, 0, 0}},
+        {{{0, 0}, {-1, 0}, {0, -1}, {-1, -1}}, -1, -1, 2, 2, {0x3, 0x3, 0x0, 0x0}, {0, 0, 0, 0}},
+        {{{0, 0}, {0, 1}, {-1, 0}, {-1, 1}}, -1, 0, 2, 2, {0x3, 0x3, 0x0, 0x0}, {1, 1, 0, 0}},
+    },
+    // S
+    {
+        {{{0, 0}, {1, 0}, {0, 1}, {-1, 1}}, -1, 0, 3, 2, {0x6, 0x3, 0x0, 0x0}, {1, 1, 0, 0}},
+        {{{0, 0}, {0, -1}, {1, 0}, {1, 1}}, 0, -1, 2, 3, {0x1, 0x3, 0x2, 0x0}, {0, 1, 0, 0}},
+        {{{0, 0}, {-1, 0}, {0, -1}, {1, -1}}, -1, -1, 3, 2, {0x6, 0x3, 0x0, 0x0}, {0, 0, -1, 0}},
+        {{{0, 0}, {0, 1}, {-1, 0}, {-1, -1}}, -1, -1, 2, 3, {0x1, 0x3, 0x2, 0x0}, {0, 1, 0, 0}},
+    },
+    // T
+    {
+        {{{0, 0}, {-1, 1}, {0, 1}, {1, 1}}, -1, 0, 3, 2, {0x2, 0x7, 0x0, 0x0}, {1, 1, 1, 0}},
+        {{{0, 0}, {1, 1}, {1, 0}, {1, -1}}, 0, -1, 2, 3, {0x2, 0x3, 0x2, 0x0}, {0, 1, 0, 0}},
+        {{{0, 0}, {1, -1}, {0, -1}, {-1, -1}}, -1, -1, 3, 2, {0x7, 0x2, 0x0, 0x0}, {-1, 0, -1, 0}},
+        {{{0, 0}, {-1, -1}, {-1, 0}, {-1, 1}}, -1, -1, 2, 3, {0x1, 0x3, 0x1, 0x0}, {1, 0, 0, 0}},
+    },
+    // Z
+    {
+        {{{0, 0}, {-1, 0}, {0, 1}, {1, 1}}, -1, 0, 3, 2, {0x3, 0x6, 0x0, 0x0}, {0, 1, 1, 0}},
+        {{{0, 0}, {0, 1}, {1, 0}, {1, -1}}, 0, -1, 2, 3, {0x2, 0x3, 0x1, 0x0}, {1, 0, 0, 0}},
+        {{{0, 0}, {1, 0}, {0, -1}, {-1, -1}}, -1, -1, 3, 2, {0x3, 0x6, 0x0, 0x0}, {-1, 0, 0, 0}},
+        {{{0, 0}, {0, -1}, {-1, 0}, {-1, 1}}, -1, -1, 2, 3, {0x2, 0x3, 0x1, 0x0}, {1, 0, 0, 0}},
+    },
+};
+
+// Pivot offsets tried in order when a rotation is blocked, the first that fits wins.
+// The I piece is four long, so it gets kicked up to two columns off a wall.
+int const MAX_KICK_TESTS = 5;
+
+struct KickTable
+{
+    int8_t count;
+    int8_t offsets[MAX_KICK_TESTS][2];
+};
+
+constexpr KickTable WALL_KICKS[TOTAL_PIECES_TYPES] = {
+    {5, {{0, 0}, {-1, 0}, {1, 0}, {-2, 0}, {2, 0}}}, // I
+    {4, {{0, 0}, {-1, 0}, {1, 0}, {0, -1}}},         // J
+    {4, {{0, 0}, {-1, 0}, {1, 0}, {0, -1}}},         // L
+    {4, {{0, 0}, {-1, 0}, {1, 0}, {0, -1}}},         // O
+    {4, {{0, 0}, {-1, 0}, {1, 0}, {0, -1}}},         // S
+    {4, {{0, 0}, {-1, 0}, {1, 0}, {0, -1}}},         // T
+    {4, {{0, 0}, {-1, 0}, {1, 0}, {0, -1}}},         // Z
+};
+
+inline PieceShape const &pieceShape(int type, int rotation)
+{
+    return PIECE_SHAPES[type][rotation & (PIECE_ORIENTATIONS - 1)];
+}
+
+// Whether every cell of shape with its pivot at (x, y) lies on the grid
+inline bool shapeFits(PieceShape const &shape, int x, int y)
+{
+    return x + shape.left >= 0 && x + shape.left + shape.width <= GRID_HORIZONTAL_SIZE && y + shape.top >= 0 &&
+           y + shape.top + shape.height <= GRID_VERTICAL_SIZE;
+}
+
+// Board mask of shape with its pivot at (x, y), which must fit the grid
+inline PieceMask shapeMask(PieceShape const &shape, int x, int y)
+{
+    int shift = x + shape.left;
+    PieceMask mask = {y + shape.top,
+                      {(uint16_t)(shape.rows[0] << shift), (uint16_t)(shape.rows[1] << shift),
+                       (uint16_t)(shape.rows[2] << shift), (uint16_t)(shape.rows[3] << shift)}};
+    return mask;
+}
+
+// Rows shape with its pivot at (x, y) falls before it lands. Constant time from the column surfaces while the
+// piece is above the stack; a piece tucked under an overhang falls back to a row by row scan.
+inline int dropDistance(Board const &board, PieceShape const &shape, int x, int y)
+{
+    int column = x + shape.left;
+    int distance = GRID_VERTICAL_SIZE;
+    for (int c = 0; c < shape.width; c++)
+    {
+        int gap = board.surface[column + c] - 1 - (y + shape.bottoms[c]);
+        if (gap < distance)
+            distance = gap;
+    }
+    if (distance >= 0)
+        return distance;
+
+    PieceMask mask = shapeMask(shape, x, y);
+    distance = 0;
+    while (!collides(board, mask, 0, 1))
+    {
+        mask.top++;
+        distance++;
+    }
+    return distance;
+}
+
+#endif // !PIECES_H
@@ -0,0 +1,90 @@
+#include "quality.h"
+
+#include <string.h>
+
+static QualitySettings const QUALITY_SETTINGS[QUALITY_LEVELS] = {
+    {1, 0.25f, false, false, false}, // Low
+    {3, 0.5f, false, true, true},    // Medium
+    {5, 1.0f, true, true, true},     // High
+};
+
+// Over budget by this much on average drops a level. Using less than this share of the budget for work raises one.
+static float const SLOW_FACTOR = 1.1f;
+static float const FAST_FACTOR = 0.5f;
+static float const CHANGE_COOLDOWN = 2.0f;
+
+// A hitch, such as a window drag, counts as this many budgets at most
+static float const MAX_SAMPLE_BUDGETS = 4.0f;
+
+QualitySettings const &qualitySettings(QualityLevel level)
+{
+    return QUALITY_SETTINGS[level];
+}
+
+void initQualityGovernor(QualityGovernor &governor, QualityLevel preset, bool automatic)
+{
+    governor.level = preset;
+    governor.ceiling = preset;
+    governor.automatic = automatic;
+    governor.next = 0;
+    governor.count = 0;
+    governor.cooldown = CHANGE_COOLDOWN;
+}
+
+void recordFrame(QualityGovernor &governor, float frameTime, float workTime, float budget)
+{
+    if (!governor.automatic)
+        return;
+
+    float maxSample = budget * MAX_SAMPLE_BUDGETS;
+    governor.frameTimes[governor.next] = frameTime < maxSample ? frameTime : maxSample;
+    governor.workTimes[governor.next] = workTime < maxSample ? workTime : maxSample;
+    governor.next = (governor.next + 1) % QUALITY_WINDOW;
+    if (governor.count < QUALITY_WINDOW)
+        governor.count++;
+
+    governor.cooldown -= frameTime;
+    if (governor.cooldown > 0 || governor.count < QUALITY_WINDOW)
+        return;
+
+    float frameSum = 0;
+    float workSum = 0;
+    for (int i = 0; i < QUALITY_WINDOW; i++)
+    {
+        frameSum += governor.frameTimes[i];
+        workSum += governor.workTimes[i];
+    }
+
+    int level = governor.level;
+    if (frameSum > budget * SLOW_FACTOR * QUALITY_WINDOW && level > QUALITY_LOW)
+        level--;
+    else if (workSum < budget * FAST_FACTOR * QUALITY_WINDOW && level < governor.ceiling)
+        level++;
+    if (level == governor.level)
+        return;
+
+    // The window measured the old level, start afresh
+    governor.level = (QualityLevel)level;
+    governor.count = 0;
+    governor.cooldown = CHANGE_COOLDOWN;
+}
+
+bool parseQuality(char const *name, QualityLevel &preset, bool &automatic)
+{
+    char const *const NAMES[QUALITY_LEVELS] = {"low", "medium", "high"};
+    automatic = strcmp(name, "auto") == 0;
+    if (automatic)
+    {
+        preset = QUALITY_HIGH;
+        return true;
+    }
+    for (int i = 0; i < QUALITY_LEVELS; i++)
+    {
+        if (strcmp(name, NAMES[i]) == 0)
+        {
+            preset = (QualityLevel)i;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,50 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+// Effect quality presets and the governor that moves between them: it watches a rolling window of frame times
+// and steps down when frames run over budget, back up when they leave plenty of headroom.
+
+enum QualityLevel
+{
+    QUALITY_LOW,
+    QUALITY_MEDIUM,
+    QUALITY_HIGH,
+    QUALITY_LEVELS
+};
+
+struct QualitySettings
+{
+    int ringCircles;        // Circles drawn per pulse ring, spread over the same ring width
+    float particleShare;    // Fraction of each particle burst that is emitted
+    bool twinklingStars;    // Each star's alpha swings around its layer's mean, otherwise stays at it
+    bool menuGlow;          // Pulsing glow behind menu titles and the selected flag
+    bool transparentWindow; // FLAG_WINDOW_TRANSPARENT, only read when the window opens
+};
+
+QualitySettings const &qualitySettings(QualityLevel level);
+
+// Frames in the rolling window, half a second at 60 fps
+int const QUALITY_WINDOW = 30;
+
+struct QualityGovernor
+{
+    QualityLevel level;
+    QualityLevel ceiling; // The preset, never exceeded
+    bool automatic;       // Fixed at the preset otherwise
+    float frameTimes[QUALITY_WINDOW];
+    float workTimes[QUALITY_WINDOW];
+    int next;
+    int count;
+    float cooldown; // Seconds before the level may change again
+};
+
+void initQualityGovernor(QualityGovernor &governor, QualityLevel preset, bool automatic);
+
+// Adds one frame: its full duration and the part spent working, i.e. not waiting for the frame cap or vsync.
+// Only frames meant to run at the full rate belong here, budget being their target duration.
+void recordFrame(QualityGovernor &governor, float frameTime, float workTime, float budget);
+
+// Parses low, medium, high or auto (HIGH, automatic)
+bool parseQuality(char const *name, QualityLevel &preset, bool &automatic);
+
+#endif // !QUALITY_H
@@ -0,0 +1,166 @@
+#include "replay.h"
+
+#include <stdio.h>
+
+static char const REPLAY_MAGIC[4] = {'T', 'S', 'R', 'P'};
+static size_t const REPLAY_HEADER_SIZE = 4 + 1 + 1 + 8;
+
+static void writeVarint(std::vector<uint8_t> &data, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back((uint8_t)value);
+}
+
+static bool readVarint(uint8_t const *data, size_t size, size_t &pos, uint32_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (pos >= size)
+            return false;
+        uint8_t byte = data[pos++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+static void writeU64(std::vector<uint8_t> &data, uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        data.push_back((uint8_t)(value >> (i * 8)));
+    }
+}
+
+static uint64_t readU64(uint8_t const *data)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        value |= (uint64_t)data[i] << (i * 8);
+    }
+    return value;
+}
+
+static uint32_t const REPLAY_DOWN_BITS = (1u << REPLAY_PRESSED_SHIFT) - 1;
+
+static uint32_t inputMask(GameInput const &input)
+{
+    return (uint32_t)input.down | ((uint32_t)input.pressed << REPLAY_PRESSED_SHIFT);
+}
+
+void beginReplay(ReplayWriter &writer, Game &game)
+{
+    writer.data.clear();
+    for (int i = 0; i < 4; i++)
+    {
+        writer.data.push_back((uint8_t)REPLAY_MAGIC[i]);
+    }
+    writer.data.push_back(REPLAY_VERSION);
+    writer.data.push_back((uint8_t)game.generator.mode);
+    writeU64(writer.data, game.seed);
+    writer.lastTick = game.tickCount;
+    writer.lastMask = 0;
+    writer.active = true;
+    game.recorder = &writer;
+}
+
+void recordTick(ReplayWriter &writer, uint32_t tick, GameInput const &input)
+{
+    // Playback holds the buttons of the last record and drops its presses after one tick,
+    // so only ticks that differ from that need a record
+    uint32_t mask = inputMask(input);
+    if (mask == writer.lastMask)
+        return;
+
+    writeVarint(writer.data, tick - writer.lastTick);
+    writeVarint(writer.data, mask);
+    writer.lastTick = tick;
+    writer.lastMask = mask & REPLAY_DOWN_BITS;
+}
+
+void endReplay(ReplayWriter &writer, Game &game)
+{
+    if (!writer.active)
+        return;
+
+    writeVarint(writer.data, game.tickCount - writer.lastTick);
+    writeVarint(writer.data, REPLAY_END_MASK);
+    writeU64(writer.data, hashGame(game));
+    writer.active = false;
+    if (game.recorder == &writer)
+        game.recorder = nullptr;
+}
+
+bool saveReplay(ReplayWriter const &writer, char const *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        return false;
+    }
+    size_t written = fwrite(writer.data.data(), 1, writer.data.size(), file);
+    fclose(file);
+    return written == writer.data.size();
+}
+
+bool loadReplay(char const *path, std::vector<uint8_t> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        return false;
+    }
+    data.clear();
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return true;
+}
+
+ReplayResult playReplay(uint8_t const *data, size_t size, Game &game)
+{
+    if (size < REPLAY_HEADER_SIZE || data[0] != REPLAY_MAGIC[0] || data[1] != REPLAY_MAGIC[1] ||
+        data[2] != REPLAY_MAGIC[2] || data[3] != REPLAY_MAGIC[3] || data[4] != REPLAY_VERSION ||
+        data[5] > GENERATOR_BAG_14)
+    {
+        return REPLAY_BAD_FORMAT;
+    }
+
+    newGame(game, readU64(data + 6), (GeneratorMode)data[5]);
+
+    size_t pos = REPLAY_HEADER_SIZE;
+    GameInput input = {0, 0};
+    uint32_t delta;
+    uint32_t mask;
+    while (readVarint(data, size, pos, delta) && readVarint(data, size, pos, mask))
+    {
+        // The previous input is held for every tick up to this record
+        for (uint32_t i = 0; i < delta; i++)
+        {
+            tick(game, input);
+            input.pressed = 0;
+        }
+
+        if (mask == REPLAY_END_MASK)
+        {
+            if (pos + 8 > size)
+                return REPLAY_BAD_FORMAT;
+            return hashGame(game) == readU64(data + pos) ? REPLAY_OK : REPLAY_HASH_MISMATCH;
+        }
+
+        input.down = (uint16_t)(mask & REPLAY_DOWN_BITS);
+        input.pressed = (uint16_t)(mask >> REPLAY_PRESSED_SHIFT);
+    }
+    return REPLAY_BAD_FORMAT;
+}
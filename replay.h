@@ -0,0 +1,51 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Compact binary input recordings that replay a game bit for bit, headless and at full speed.
+//
+// Layout: "TSRP", version byte, generator mode byte, seed (u64 little endian), then one record per
+// tick whose input differs from the previous record: varint tick delta, varint input mask
+// (down | pressed << REPLAY_PRESSED_SHIFT). The stream ends with a record whose mask is REPLAY_END_MASK,
+// its delta reaching the final tick, followed by the final state hash (u64 little endian).
+
+#include "game.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+uint8_t const REPLAY_VERSION = 3; // Bumped whenever the rules or the state hash change for the same inputs
+int const REPLAY_PRESSED_SHIFT = 9; // Nine buttons, INPUT_LEFT to INPUT_SKIP
+uint32_t const REPLAY_END_MASK = 0x80000000u;
+
+struct ReplayWriter
+{
+    std::vector<uint8_t> data;
+    uint32_t lastTick;
+    uint32_t lastMask;
+    bool active;
+};
+
+// Starts a recording of a game that was just created with newGame, and attaches it to the game
+void beginReplay(ReplayWriter &writer, Game &game);
+
+// Called by the game for every tick it runs while a recorder is attached
+void recordTick(ReplayWriter &writer, uint32_t tick, GameInput const &input);
+
+// Writes the final tick and state hash, and detaches the recorder from the game
+void endReplay(ReplayWriter &writer, Game &game);
+
+bool saveReplay(ReplayWriter const &writer, char const *path);
+bool loadReplay(char const *path, std::vector<uint8_t> &data);
+
+enum ReplayResult
+{
+    REPLAY_OK,
+    REPLAY_BAD_FORMAT,
+    REPLAY_HASH_MISMATCH
+};
+
+// Re-simulates a recording into game as fast as possible and checks the final state hash
+ReplayResult playReplay(uint8_t const *data, size_t size, Game &game);
+
+#endif // !REPLAY_H
@@ -0,0 +1,43 @@
+// tetris-replay: re-simulates recorded sessions headless at full speed and checks their final state.
+// Usage: tetris-replay FILE...
+
+#include "replay.h"
+
+#include <chrono>
+#include <stdio.h>
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s FILE...\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        std::vector<uint8_t> data;
+        if (!loadReplay(argv[i], data))
+        {
+            printf("%s: cannot read\n", argv[i]);
+            failures++;
+            continue;
+        }
+
+        Game game;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ReplayResult result = playReplay(data.data(), data.size(), game);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        char const *status = result == REPLAY_OK              ? "OK"
+                             : result == REPLAY_HASH_MISMATCH ? "HASH MISMATCH"
+                                                              : "BAD FORMAT";
+        printf("%s: %s, %u ticks (%.1f s of play) in %.3f ms, %.0f ticks/s, level %d, %d lines, %d bytes\n", argv[i],
+               status, game.tickCount, game.tickCount * SIM_DT, seconds * 1000.0,
+               seconds > 0 ? game.tickCount / seconds : 0.0, game.level, game.linesClearedTotal, (int)data.size());
+        if (result != REPLAY_OK)
+            failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
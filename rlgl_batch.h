@@ -0,0 +1,29 @@
+#ifndef RLGL_BATCH_H
+#define RLGL_BATCH_H
+
+// The few rlgl immediate-mode calls the batched particle and draw list submissions make. rlgl is compiled into
+// libraylib; its header ships with raylib but not in include/, so this uses it when it is there and otherwise
+// declares the subset needed, signatures and RL_QUADS as in raylib 5.x rlgl.h. Keep both files on this one copy.
+
+#if defined(__has_include)
+#if __has_include("rlgl.h")
+#include "rlgl.h"
+#endif
+#endif
+
+#ifndef RLGL_H
+extern "C"
+{
+    void rlBegin(int mode);
+    void rlEnd(void);
+    void rlVertex2f(float x, float y);
+    void rlTexCoord2f(float x, float y);
+    void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+    void rlSetTexture(unsigned int id);
+    bool rlCheckRenderBatchLimit(int vCount);
+}
+
+#define RL_QUADS 0x0007
+#endif // !RLGL_H
+
+#endif // !RLGL_BATCH_H
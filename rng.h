@@ -0,0 +1,94 @@
+#ifndef RNG_H
+#define RNG_H
+
+// Small, seedable PRNG (xoshiro128**) with no shared state, so every game, replay or thread owns its
+// own stream and the same seed gives the same numbers on every platform.
+
+#include <stdint.h>
+
+struct Rng
+{
+    uint32_t s[4];
+};
+
+inline uint64_t splitMix64(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Expands a 64-bit seed into the full state; `stream` picks independent sequences from the same seed
+inline void seedRng(Rng &rng, uint64_t seed, uint64_t stream = 0)
+{
+    uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ull);
+    uint64_t a = splitMix64(state);
+    uint64_t b = splitMix64(state);
+    rng.s[0] = (uint32_t)a;
+    rng.s[1] = (uint32_t)(a >> 32);
+    rng.s[2] = (uint32_t)b;
+    rng.s[3] = (uint32_t)(b >> 32);
+}
+
+inline uint32_t rotl32(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+inline uint32_t nextRandom(Rng &rng)
+{
+    uint32_t *s = rng.s;
+    uint32_t result = rotl32(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl32(s[3], 11);
+
+    return result;
+}
+
+// Uniform in [0, bound), without modulo bias (Lemire's multiply and reject)
+inline uint32_t randomBelow(Rng &rng, uint32_t bound)
+{
+    uint64_t m = (uint64_t)nextRandom(rng) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            m = (uint64_t)nextRandom(rng) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+// Uniform in [min, max], both included
+inline int randomRange(Rng &rng, int min, int max)
+{
+    return min + (int)randomBelow(rng, (uint32_t)(max - min + 1));
+}
+
+// Uniform in [0, 1)
+inline float randomFloat(Rng &rng)
+{
+    return (nextRandom(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Fills values[0, count) with uniform floats in [min, max), one tight loop instead of a call per value
+inline void fillRandomFloats(Rng &rng, float *values, int count, float min, float max)
+{
+    float scale = (max - min) * (1.0f / 16777216.0f);
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = min + (nextRandom(rng) >> 8) * scale;
+    }
+}
+
+#endif // !RNG_H
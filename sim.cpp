@@ -0,0 +1,224 @@
+// tetris-sim: plays many headless games in parallel and reports throughput and outcome distributions.
+// Usage: tetris-sim [--games N] [--threads N] [--seed S] [--mode random|bag7|bag14] [--max-pieces N]
+//                   [--replay FILE...]
+// Without --replay every game is played by the built-in bot from seed S + game index. With --replay the
+// given recordings are re-simulated round robin until N games have run, and every one is hash-checked.
+
+#include "bot.h"
+#include "replay.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+struct SimOptions
+{
+    int games;
+    int threads;
+    uint64_t seed;
+    GeneratorMode mode;
+    uint32_t maxPieces;
+    std::vector<std::vector<uint8_t>> replays;
+};
+
+struct SimResult
+{
+    uint32_t ticks;
+    uint32_t pieces;
+    int lines;
+    int level;
+    bool failed; // Replay did not reproduce its recorded state
+};
+
+// Longest a bot game may run, whatever --max-pieces says: one hour of play
+static uint32_t const MAX_TICKS = SIM_TICK_RATE * 60 * 60;
+
+static void playBotGame(SimOptions const &options, int index, Game &game, SimResult &result)
+{
+    newGame(game, options.seed + (uint64_t)index, options.mode);
+    Bot bot;
+    initBot(bot);
+    while (game.phase != PHASE_OVER && game.piecesSpawned <= options.maxPieces && game.tickCount < MAX_TICKS)
+    {
+        tick(game, botInput(bot, game));
+    }
+    result.failed = false;
+}
+
+static void playReplayGame(SimOptions const &options, int index, Game &game, SimResult &result)
+{
+    std::vector<uint8_t> const &data = options.replays[index % options.replays.size()];
+    result.failed = playReplay(data.data(), data.size(), game) != REPLAY_OK;
+}
+
+static void worker(SimOptions const &options, std::atomic<int> &nextGame, std::vector<SimResult> &results)
+{
+    // Game is large and every game fully resets it, so each worker keeps one
+    Game game;
+    for (int index = nextGame++; index < options.games; index = nextGame++)
+    {
+        SimResult &result = results[index];
+        if (options.replays.empty())
+            playBotGame(options, index, game, result);
+        else
+            playReplayGame(options, index, game, result);
+        result.ticks = game.tickCount;
+        result.pieces = game.piecesSpawned;
+        result.lines = game.linesClearedTotal;
+        result.level = game.level;
+    }
+}
+
+static void printHistogram(char const *title, std::vector<int> const &counts, int bucketSize, int games)
+{
+    printf("%s:\n", title);
+    for (size_t i = 0; i < counts.size(); i++)
+    {
+        if (counts[i] == 0)
+            continue;
+        int bar = (int)(counts[i] * 50LL / games);
+        if (bucketSize == 1)
+            printf("  %8d %7d %5.1f%% ", (int)i, counts[i], 100.0 * counts[i] / games);
+        else
+            printf("  %4d-%-4d %6d %5.1f%% ", (int)i * bucketSize, ((int)i + 1) * bucketSize - 1, counts[i],
+                   100.0 * counts[i] / games);
+        for (int j = 0; j < bar; j++)
+        {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+}
+
+static bool parseOptions(int argc, char **argv, SimOptions &options)
+{
+    options.games = 1000;
+    options.threads = (int)std::thread::hardware_concurrency();
+    options.seed = 1;
+    options.mode = GENERATOR_BAG_7;
+    options.maxPieces = 1000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--games") == 0 && hasValue)
+            options.games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue)
+            options.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+            options.seed = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--max-pieces") == 0 && hasValue)
+            options.maxPieces = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--mode") == 0 && hasValue)
+        {
+            char const *mode = argv[++i];
+            if (strcmp(mode, "random") == 0)
+                options.mode = GENERATOR_RANDOM;
+            else if (strcmp(mode, "bag7") == 0)
+                options.mode = GENERATOR_BAG_7;
+            else if (strcmp(mode, "bag14") == 0)
+                options.mode = GENERATOR_BAG_14;
+            else
+                return false;
+        }
+        else if (strcmp(argv[i], "--replay") == 0)
+        {
+            for (i++; i < argc; i++)
+            {
+                options.replays.push_back(std::vector<uint8_t>());
+                if (!loadReplay(argv[i], options.replays.back()))
+                {
+                    printf("%s: cannot read\n", argv[i]);
+                    return false;
+                }
+            }
+            if (options.replays.empty())
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (options.threads < 1)
+        options.threads = 1;
+    return options.games > 0;
+}
+
+int main(int argc, char **argv)
+{
+    SimOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printf("Usage: %s [--games N] [--threads N] [--seed S] [--mode random|bag7|bag14] [--max-pieces N] "
+               "[--replay FILE...]\n",
+               argv[0]);
+        return 2;
+    }
+
+    std::vector<SimResult> results(options.games);
+    std::atomic<int> nextGame(0);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::clock_t cpuStart = std::clock();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < options.threads; i++)
+    {
+        threads.push_back(std::thread(worker, std::cref(options), std::ref(nextGame), std::ref(results)));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double cpuSeconds = (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    uint64_t ticks = 0;
+    uint64_t pieces = 0;
+    uint64_t lines = 0;
+    int failures = 0;
+    int maxLines = 0;
+    int maxLevel = 0;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        ticks += results[i].ticks;
+        pieces += results[i].pieces;
+        lines += results[i].lines;
+        failures += results[i].failed ? 1 : 0;
+        if (results[i].lines > maxLines)
+            maxLines = results[i].lines;
+        if (results[i].level > maxLevel)
+            maxLevel = results[i].level;
+    }
+
+    printf("%d games on %d threads in %.3f s (%s)\n", options.games, options.threads, seconds,
+           options.replays.empty() ? "bot" : "replays");
+    printf("  %.1f games/s, %.0f pieces/s, %.0f ticks/s\n", options.games / seconds, pieces / seconds,
+           ticks / seconds);
+    // CPU cost of one tick across all threads, the bot's planning included
+    printf("  %.1f ns of CPU per tick\n", ticks > 0 ? cpuSeconds * 1e9 / ticks : 0.0);
+    printf("  %.1f lines and %.1f pieces per game on average\n", (double)lines / options.games,
+           (double)pieces / options.games);
+    if (failures > 0)
+        printf("  %d replays did not reproduce their recorded state\n", failures);
+
+    int const LINE_BUCKETS = 20;
+    int lineBucket = maxLines / LINE_BUCKETS + 1;
+    std::vector<int> lineCounts(LINE_BUCKETS + 1, 0);
+    std::vector<int> levelCounts(maxLevel + 1, 0);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        lineCounts[results[i].lines / lineBucket]++;
+        levelCounts[results[i].level]++;
+    }
+    printHistogram("Lines cleared", lineCounts, lineBucket, options.games);
+    printHistogram("Level reached", levelCounts, 1, options.games);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+#include "sim_thread.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+struct Snapshot
+{
+    Game game;
+    Clock::time_point published;
+};
+
+// Triple buffer: the simulation fills buffers[back], then swaps it with the middle one and marks that fresh; the
+// reader swaps a fresh middle with buffers[front]. Each side owns its own buffer outright in between.
+static int const FRESH = 4;
+static Snapshot buffers[3];
+static std::atomic<int> middle(2);
+static int back = 0;  // Simulation side
+static int front = 1; // Reader side
+
+static std::thread simulation;
+static std::atomic<bool> running(false);
+static std::atomic<bool> active(true);
+static std::atomic<uint16_t> inputDown(0);
+static std::atomic<uint16_t> inputPressed(0);
+
+// Events, linesCleared and clearedRows of the snapshot in the middle. While the reader has not taken it, the next
+// snapshot replaces it and repeats them ahead of its own.
+static unsigned int carriedEvents;
+static int carriedLines;
+static int carriedRows[GRID_VERTICAL_SIZE];
+
+static void carryEvents(Game &snapshot, Game const &game)
+{
+    snapshot.events = carriedEvents | game.events;
+    snapshot.linesCleared = carriedLines;
+    for (int i = 0; i < carriedLines; i++)
+    {
+        snapshot.clearedRows[i] = carriedRows[i];
+    }
+    for (int i = 0; i < game.linesCleared && snapshot.linesCleared < GRID_VERTICAL_SIZE; i++)
+    {
+        snapshot.clearedRows[snapshot.linesCleared++] = game.clearedRows[i];
+    }
+}
+
+static void publish(Game const &game)
+{
+    Snapshot &snapshot = buffers[back];
+    snapshot.game = game;
+    snapshot.published = Clock::now();
+
+    // Whether the middle one is skipped is only settled by the swap itself: carry its events on the guess that it
+    // is, and if the reader takes it first, publish this step's events alone
+    int previous = middle.load(std::memory_order_relaxed);
+    if (previous & FRESH)
+    {
+        carryEvents(snapshot.game, game);
+        if (!middle.compare_exchange_strong(previous, back | FRESH, std::memory_order_acq_rel))
+        {
+            snapshot.game = game;
+            previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+        }
+    }
+    else
+    {
+        previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+    }
+
+    carriedEvents = snapshot.game.events;
+    carriedLines = snapshot.game.linesCleared;
+    for (int i = 0; i < carriedLines; i++)
+    {
+        carriedRows[i] = snapshot.game.clearedRows[i];
+    }
+    back = previous & ~FRESH;
+}
+
+static void run(Game *game)
+{
+    Clock::time_point last = Clock::now();
+    while (running.load(std::memory_order_relaxed))
+    {
+        Clock::time_point now = Clock::now();
+        float dt = std::chrono::duration<float>(now - last).count();
+        last = now;
+        if (!active.load(std::memory_order_relaxed))
+        {
+            std::this_thread::sleep_for(std::chrono::duration<float>(SIM_DT));
+            continue;
+        }
+
+        GameInput input = {inputDown.load(std::memory_order_relaxed),
+                           inputPressed.exchange(0, std::memory_order_relaxed)};
+        step(*game, input, dt);
+        publish(*game);
+
+        // Wake when the next tick is due, the accumulator holding the part of it already elapsed
+        std::this_thread::sleep_until(now + std::chrono::duration_cast<Clock::duration>(
+                                                std::chrono::duration<float>(SIM_DT - game->accumulator)));
+    }
+}
+
+void startSimulation(Game &game)
+{
+    stopSimulation();
+
+    middle.store(2);
+    back = 0;
+    front = 1;
+    carriedEvents = 0;
+    carriedLines = 0;
+    inputDown.store(0);
+    inputPressed.store(0);
+    game.events = 0;
+    game.linesCleared = 0;
+
+    running.store(true);
+    simulation = std::thread(run, &game);
+}
+
+void stopSimulation()
+{
+    if (!simulation.joinable())
+        return;
+    running.store(false);
+    simulation.join();
+}
+
+void setSimulationActive(bool isActive)
+{
+    active.store(isActive, std::memory_order_relaxed);
+}
+
+void postSimulationInput(GameInput const &input)
+{
+    inputDown.store(input.down, std::memory_order_relaxed);
+    inputPressed.fetch_or(input.pressed, std::memory_order_relaxed);
+}
+
+bool takeSnapshot(Game &game)
+{
+    if (!(middle.load(std::memory_order_acquire) & FRESH))
+        return false;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+    game = buffers[front].game;
+    return true;
+}
+
+float snapshotAlpha(Game const &game)
+{
+    float elapsed = std::chrono::duration<float>(Clock::now() - buffers[front].published).count();
+    float alpha = (game.accumulator + elapsed) / SIM_DT;
+    return alpha < 1.0f ? alpha : 1.0f;
+}
@@ -0,0 +1,36 @@
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+// Runs the fixed-tick simulation on its own thread, on its own clock, so a long frame or a stalled buffer swap never
+// holds ticks back. The main thread posts input, the simulation publishes a copy of the game after every step
+// through a triple buffer: neither side ever waits for the other and the reader always gets the newest complete
+// snapshot.
+//
+// Rendering stays on the main thread: raylib binds the GL context to it and can only poll input there. Between
+// frames the main thread polls at the tick rate and posts every poll, so a press made while it waits for the next
+// frame reaches the simulation within a tick. A press made while it draws or is stalled in the buffer swap still
+// waits for the frame to end.
+
+#include "game.h"
+
+// Hands game to a new simulation thread, which steps it until stopSimulation(). The caller must not touch game,
+// nor the replay it records into, in between.
+void startSimulation(Game &game);
+
+// Joins the thread, game belongs to the caller again. Does nothing if no simulation runs.
+void stopSimulation();
+
+// While inactive no ticks run and the time does not count, as when a menu covers the game
+void setSimulationActive(bool active);
+
+// Buttons held replace the previous ones, presses add up until a step takes them. Called after every input poll.
+void postSimulationInput(GameInput const &input);
+
+// Copies the newest snapshot into game and returns true, or returns false if none was published since the last
+// call. The snapshot's events, linesCleared and clearedRows cover every step since the last snapshot taken.
+bool takeSnapshot(Game &game);
+
+// interpolationAlpha() for the last snapshot taken, counting the time since it was published
+float snapshotAlpha(Game const &game);
+
+#endif // !SIM_THREAD_H
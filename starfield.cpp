@@ -0,0 +1,103 @@
+#include "starfield.h"
+
+#include "cosmetic_rng.h"
+#include "rlgl_batch.h"
+
+#include <math.h>
+
+struct StarLayer
+{
+    int count;
+    float minSize;
+    float maxSize;
+    float drift;      // Pixels per second, leftwards
+    float parallax;   // Share of the shake offset the layer follows
+    float brightness; // Mean alpha
+};
+
+// Far to near, the counts adding up to MAX_FIELD_STARS
+constexpr StarLayer STAR_LAYER_SETTINGS[STAR_LAYERS] = {
+    {300, 1.0f, 1.5f, 4.0f, 0.2f, 120.0f},
+    {150, 1.5f, 2.5f, 10.0f, 0.5f, 180.0f},
+    {62, 2.5f, 3.5f, 24.0f, 1.0f, 240.0f},
+};
+
+static_assert(STAR_LAYER_SETTINGS[0].count + STAR_LAYER_SETTINGS[1].count + STAR_LAYER_SETTINGS[2].count ==
+                  MAX_FIELD_STARS,
+              "The layers must fill the starfield");
+
+// Twinkling swings a star's alpha this far either side of its mean
+static float const TWINKLE_DEPTH = 0.6f;
+
+void generateStarfield(Starfield &field, Rng &rng, int width, int height)
+{
+    field.count = 0;
+    field.width = (float)width;
+    field.height = (float)height;
+    for (int l = 0; l < STAR_LAYERS; l++)
+    {
+        StarLayer const &layer = STAR_LAYER_SETTINGS[l];
+        int first = field.count;
+        fillRandomFloats(rng, field.x + first, layer.count, 0.0f, field.width);
+        fillRandomFloats(rng, field.y + first, layer.count, 0.0f, field.height);
+        fillRandomFloats(rng, field.size + first, layer.count, layer.minSize, layer.maxSize);
+        fillRandomFloats(rng, field.twinklePhase + first, layer.count, 0.0f, 2 * PI);
+        fillRandomFloats(rng, field.twinkleRate + first, layer.count, 2.0f, 6.0f);
+        for (int i = first; i < first + layer.count; i++)
+        {
+            field.layer[i] = (uint8_t)l;
+        }
+        field.count += layer.count;
+    }
+}
+
+void drawStarfield(Starfield const &field, float time, Vector2 shake, bool twinkle)
+{
+    // Same solid-colour texel the shape functions use, as for the particles
+    Texture2D shapes = GetShapesTexture();
+    Rectangle texel = GetShapesTextureRectangle();
+    float u = (texel.x + texel.width / 2) / shapes.width;
+    float v = (texel.y + texel.height / 2) / shapes.height;
+
+    // Layer offsets are the same for all their stars, so they are worked out once
+    float drift[STAR_LAYERS];
+    Vector2 parallax[STAR_LAYERS];
+    for (int l = 0; l < STAR_LAYERS; l++)
+    {
+        StarLayer const &layer = STAR_LAYER_SETTINGS[l];
+        drift[l] = fmodf(time * layer.drift, field.width);
+        parallax[l] = {shake.x * layer.parallax, shake.y * layer.parallax};
+    }
+
+    rlSetTexture(shapes.id);
+    rlCheckRenderBatchLimit(4 * field.count);
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < field.count; i++)
+    {
+        int l = field.layer[i];
+        float x = field.x[i] - drift[l];
+        if (x < 0)
+            x += field.width;
+
+        float alpha = STAR_LAYER_SETTINGS[l].brightness;
+        if (twinkle)
+            alpha *= 1.0f + TWINKLE_DEPTH * sinf(field.twinklePhase[i] + time * field.twinkleRate[i]);
+        rlColor4ub(255, 255, 255, (unsigned char)(alpha < 255.0f ? alpha : 255.0f));
+
+        float half = field.size[i] / 2;
+        float left = x + parallax[l].x - half;
+        float top = field.y[i] + parallax[l].y - half;
+        float right = left + field.size[i];
+        float bottom = top + field.size[i];
+        rlTexCoord2f(u, v);
+        rlVertex2f(left, top);
+        rlTexCoord2f(u, v);
+        rlVertex2f(left, bottom);
+        rlTexCoord2f(u, v);
+        rlVertex2f(right, bottom);
+        rlTexCoord2f(u, v);
+        rlVertex2f(right, top);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
@@ -0,0 +1,35 @@
+#ifndef STARFIELD_H
+#define STARFIELD_H
+
+// Level transition background: stars in parallax layers, generated once at startup. Drawing only drifts and
+// twinkles the precomputed stars as a function of time, all of them one rlgl quad batch like the particles.
+
+#include "raylib.h"
+#include "rng.h"
+
+#include <stdint.h>
+
+int const STAR_LAYERS = 3;
+int const MAX_FIELD_STARS = 512;
+
+struct Starfield
+{
+    int count;
+    float width;
+    float height;
+    float x[MAX_FIELD_STARS]; // Position at time 0
+    float y[MAX_FIELD_STARS];
+    float size[MAX_FIELD_STARS];
+    float twinklePhase[MAX_FIELD_STARS]; // Radians at time 0
+    float twinkleRate[MAX_FIELD_STARS];  // Radians per second
+    uint8_t layer[MAX_FIELD_STARS];
+};
+
+void generateStarfield(Starfield &field, Rng &rng, int width, int height);
+
+// Writes every star as a quad of the shapes texture straight to rlgl, for a draw list custom command.
+// Nearer layers drift faster and follow the shake offset further. Without twinkle every star keeps its mean
+// brightness.
+void drawStarfield(Starfield const &field, float time, Vector2 shake, bool twinkle);
+
+#endif // !STARFIELD_H
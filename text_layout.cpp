@@ -0,0 +1,104 @@
+#include "text_layout.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// Sizes kept per localized string: the largest set, a title with its three glow layers
+static int const LAYOUT_SIZES = 4;
+
+// Direct mapped: a colliding entry is simply replaced, the screens format far fewer strings than this
+static int const TEXT_MEASURE_SLOTS = 512;
+
+struct LocalizedLayout
+{
+    float fontSize; // 0 marks an empty entry
+    TextLayout layout;
+};
+
+struct TextMeasure
+{
+    uint64_t key;
+    bool valid;
+    Vector2 size;
+};
+
+static Font layoutFont;
+static int layoutWidth;
+static LocalizedLayout localizedLayouts[BUILTIN_LANGUAGES + 1][STRING_COUNT][LAYOUT_SIZES];
+static int nextReplaced[BUILTIN_LANGUAGES + 1][STRING_COUNT]; // Entry to reuse once all sizes are taken
+static TextMeasure measures[TEXT_MEASURE_SLOTS];
+
+void setTextLayoutTarget(Font font, int windowWidth)
+{
+    if (font.texture.id == layoutFont.texture.id && font.recs == layoutFont.recs && windowWidth == layoutWidth)
+        return;
+    layoutFont = font;
+    layoutWidth = windowWidth;
+    clearTextLayouts();
+}
+
+TextLayout const &localizedLayout(Language language, StringId id, float fontSize)
+{
+    LocalizedLayout *entries = localizedLayouts[language][id];
+    for (int i = 0; i < LAYOUT_SIZES; i++)
+    {
+        if (entries[i].fontSize == fontSize)
+            return entries[i].layout;
+    }
+
+    int slot = 0;
+    while (slot < LAYOUT_SIZES && entries[slot].fontSize != 0)
+    {
+        slot++;
+    }
+    if (slot == LAYOUT_SIZES)
+    {
+        slot = nextReplaced[language][id];
+        nextReplaced[language][id] = (slot + 1) % LAYOUT_SIZES;
+    }
+
+    LocalizedLayout &entry = entries[slot];
+    entry.fontSize = fontSize;
+    entry.layout.size = MeasureTextEx(layoutFont, localizedString(language, id), fontSize, 1);
+    entry.layout.centeredX = (float)layoutWidth / 2 - entry.layout.size.x / 2;
+    return entry.layout;
+}
+
+static uint64_t hashBytes(uint64_t hash, void const *data, size_t size)
+{
+    uint8_t const *bytes = (uint8_t const *)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+Vector2 measureTextCached(Font font, char const *text, float fontSize, float spacing)
+{
+    uint64_t key = 0xCBF29CE484222325ull;
+    key = hashBytes(key, &font.texture.id, sizeof(font.texture.id));
+    key = hashBytes(key, &fontSize, sizeof(fontSize));
+    key = hashBytes(key, &spacing, sizeof(spacing));
+    key = hashBytes(key, text, strlen(text));
+
+    TextMeasure &measure = measures[key % TEXT_MEASURE_SLOTS];
+    if (!measure.valid || measure.key != key)
+    {
+        measure.key = key;
+        measure.valid = true;
+        measure.size = MeasureTextEx(font, text, fontSize, spacing);
+    }
+    return measure.size;
+}
+
+void clearTextLayouts()
+{
+    memset(localizedLayouts, 0, sizeof(localizedLayouts));
+    memset(nextReplaced, 0, sizeof(nextReplaced));
+    for (int i = 0; i < TEXT_MEASURE_SLOTS; i++)
+    {
+        measures[i].valid = false;
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+// Memoized text layout. MeasureTextEx walks every codepoint and searches the font's glyphs for each one, and the
+// screens centre dozens of strings although they only change with the language, the window or the player's input.
+// Localized strings are laid out once per (language, string id, size); formatted text is memoized by content.
+
+#include "localization.h"
+#include "raylib.h"
+
+// Where a localized string goes at one size
+struct TextLayout
+{
+    Vector2 size;    // MeasureTextEx with spacing 1, as every screen draws
+    float centeredX; // Left edge that centres the string in the window
+};
+
+// Sets the font and window width layouts are computed for, forgetting them all if either changed
+void setTextLayoutTarget(Font font, int windowWidth);
+
+// Layout of string id in language at fontSize, computed on first use and kept until the target changes
+TextLayout const &localizedLayout(Language language, StringId id, float fontSize);
+
+// MeasureTextEx, computed once per distinct (font, text, size, spacing) and looked up afterwards.
+// The text is keyed by content, so TextFormat results and edited buffers are cached correctly too.
+Vector2 measureTextCached(Font font, char const *text, float fontSize, float spacing);
+
+// Forgets every layout and measurement, needed when a font or a language pack is reloaded
+void clearTextLayouts();
+
+#endif // !TEXT_LAYOUT_H
@@ -0,0 +1,127 @@
+#include "texture_atlas.h"
+
+#include <math.h>
+#include <string.h>
+
+// What LoadFontEx uses when given no codepoints: the 95 printable ASCII characters, 4 texels apart
+static int const FONT_GLYPHS = 95;
+static int const FONT_GLYPH_PADDING = 4;
+
+Texture2D buildAtlas(Image const *images, int count, int padding, Rectangle *regions)
+{
+    Texture2D atlas = {0};
+    if (count > MAX_ATLAS_IMAGES)
+        return atlas;
+
+    // Tallest first, so each shelf is as tall as its first image
+    int order[MAX_ATLAS_IMAGES];
+    int area = 0;
+    int width = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int j = i;
+        while (j > 0 && images[order[j - 1]].height < images[i].height)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+        area += (images[i].width + padding) * (images[i].height + padding);
+        if (images[i].width > width)
+            width = images[i].width;
+    }
+    // At least square, in case every image is narrow
+    int side = (int)ceilf(sqrtf((float)area));
+    if (side > width)
+        width = side;
+
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    for (int i = 0; i < count; i++)
+    {
+        Image const &image = images[order[i]];
+        Rectangle &region = regions[order[i]];
+        if (image.data == nullptr)
+        {
+            region = {0, 0, 0, 0};
+            continue;
+        }
+        if (x + image.width > width)
+        {
+            x = 0;
+            y += shelfHeight + padding;
+            shelfHeight = 0;
+        }
+        region = {(float)x, (float)y, (float)image.width, (float)image.height};
+        x += image.width + padding;
+        if (image.height > shelfHeight)
+            shelfHeight = image.height;
+    }
+    int height = y + shelfHeight;
+    if (width > MAX_ATLAS_SIZE || height > MAX_ATLAS_SIZE)
+        return atlas;
+
+    // Rows are copied rather than drawn with ImageDraw, whose blending would change partly transparent texels
+    Image packed = GenImageColor(width, height, BLANK);
+    unsigned char *pixels = (unsigned char *)packed.data;
+    for (int i = 0; i < count; i++)
+    {
+        if (images[i].data == nullptr)
+            continue;
+        Image copy = ImageCopy(images[i]);
+        ImageFormat(&copy, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        int left = (int)regions[i].x;
+        int top = (int)regions[i].y;
+        for (int row = 0; row < copy.height; row++)
+        {
+            memcpy(pixels + ((top + row) * width + left) * 4, (unsigned char *)copy.data + row * copy.width * 4,
+                   copy.width * 4);
+        }
+        UnloadImage(copy);
+    }
+
+    atlas = LoadTextureFromImage(packed);
+    UnloadImage(packed);
+    return atlas;
+}
+
+bool loadFontGlyphs(char const *fileName, int fontSize, Font &font, Image &glyphImage)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    GlyphInfo *glyphs = data != nullptr
+                            ? LoadFontData(data, dataSize, fontSize, nullptr, FONT_GLYPHS, FONT_DEFAULT)
+                            : nullptr;
+    UnloadFileData(data);
+    if (glyphs == nullptr)
+        return false;
+
+    font.baseSize = fontSize;
+    font.glyphCount = FONT_GLYPHS;
+    font.glyphPadding = FONT_GLYPH_PADDING;
+    font.glyphs = glyphs;
+    font.recs = nullptr;
+    glyphImage = GenImageFontAtlas(glyphs, &font.recs, FONT_GLYPHS, fontSize, FONT_GLYPH_PADDING, 0);
+    font.texture = {0};
+    return true;
+}
+
+void placeFont(Font &font, Texture2D atlas, Rectangle region)
+{
+    for (int i = 0; i < font.glyphCount; i++)
+    {
+        font.recs[i].x += region.x;
+        font.recs[i].y += region.y;
+    }
+    font.texture = atlas;
+}
+
+void unloadFontGlyphs(Font &font)
+{
+    UnloadFontData(font.glyphs, font.glyphCount);
+    MemFree(font.recs);
+    font.glyphs = nullptr;
+    font.recs = nullptr;
+    font.texture = {0};
+}
@@ -0,0 +1,28 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+// One texture for everything the screens draw from: font glyphs, flags, baked sprites and the solid texel shapes
+// and particles are drawn with, packed at startup so a frame binds a single texture instead of one per kind of
+// image. Render textures redrawn while running (the board, the menus) stay separate.
+
+#include "raylib.h"
+
+int const MAX_ATLAS_IMAGES = 16;
+int const MAX_ATLAS_SIZE = 4096;
+
+// Packs the images into shelves, tallest first, with padding empty texels between them, and uploads the result.
+// regions[i] receives where images[i] went; an image without data gets an empty region. Returns a texture with id 0
+// when the images do not fit in MAX_ATLAS_SIZE.
+Texture2D buildAtlas(Image const *images, int count, int padding, Rectangle *regions);
+
+// Loads a TrueType font like LoadFontEx with the default character set, but returns its glyph atlas as an image
+// for buildAtlas() instead of uploading it. Returns false if the file cannot be read.
+bool loadFontGlyphs(char const *fileName, int fontSize, Font &font, Image &glyphImage);
+
+// Points the font at its glyph image's region of the atlas
+void placeFont(Font &font, Texture2D atlas, Rectangle region);
+
+// Frees what loadFontGlyphs() allocated, the atlas being unloaded on its own
+void unloadFontGlyphs(Font &font);
+
+#endif // !TEXTURE_ATLAS_H